@@ -0,0 +1,70 @@
+/******************************************************************************
+ * Copyright (c) 2025 Marconatale Parise.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * You may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************/
+/**
+ * @file mlx90632_bench_host.c
+ * @brief host runner of the melexis microbenchmark
+ *
+ * Usage: mlx90632_bench [iterations] [/dev/i2c-N]
+ *
+ * Without an i2c-dev node the library runs on the in-memory register file of
+ * mlx90632_fake_bus.h, so bus stages measure only the library overhead. With a node the real
+ * sensor is used.
+ *
+ */
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdlib.h>
+#include <string.h>
+#include "mlx90632.h"
+#include "mlx90632_bench.h"
+#include "mlx90632_hal.h"
+#include "mlx90632_fake_bus.h"
+
+#define BENCH_ITERATIONS 1000 /**< Default timed runs per stage */
+
+int main(int argc, char **argv){
+    MLXBench_s bench;
+    uint32_t iterations = BENCH_ITERATIONS;
+    int32_t ret;
+
+    if (argc > 1)
+        iterations = (uint32_t)strtoul(argv[1], NULL, 0);
+
+    if (argc > 2){
+        ret = mlx90632_bus_linux_open(argv[2], MLX90632_I2C_ADDR);
+        if (ret < 0){
+            fprintf(stderr, "cannot open %s: %s\n", argv[2], strerror(-ret));
+            return 1;
+        }
+    } else {
+        fake_bus_setup();
+    }
+
+    ret = mlx90632_init();
+    if (ret < 0){
+        fprintf(stderr, "sensor init failed: %d\n", ret);
+        return 1;
+    }
+
+    mlx90632_i2c_reset_stats();
+    ret = mlx90632_bench_run(iterations, &bench);
+    mlx90632_bench_print(&bench);
+    mlx90632_i2c_dump_stats();
+
+    mlx90632_bus_linux_close();
+    return (ret < 0) ? 1 : 0;
+}
@@ -0,0 +1,140 @@
+/******************************************************************************
+ * Copyright (c) 2025 Marconatale Parise.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * You may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************/
+/**
+ * @file mlx90632_fake_bus.c
+ * @brief in-memory register file of a medical sensor
+ *
+ */
+#include <string.h>
+#include "mlx90632_fake_bus.h"
+#include "mlx90632_hal.h"
+
+uint16_t fake_regs[0x10000];
+MLXFakeBus_s fake;
+
+/* Eeprom image of a medical sensor, 32-bit constants are stored low word first */
+static const struct {
+    uint16_t addr;
+    int32_t value;
+    uint8_t width;
+} fake_calib[] = {
+    { MLX90632_EE_P_R, 0x00587f5b, 32 },
+    { MLX90632_EE_P_G, 0x04a10289, 32 },
+    { MLX90632_EE_P_T, (int32_t)0xfff966f8, 32 },
+    { MLX90632_EE_P_O, 0x00001e0f, 32 },
+    { MLX90632_EE_Ea, 4859535, 32 },
+    { MLX90632_EE_Eb, 5686508, 32 },
+    { MLX90632_EE_Fa, 53855361, 32 },
+    { MLX90632_EE_Fb, 42874149, 32 },
+    { MLX90632_EE_Ga, -14556410, 32 },
+    { MLX90632_EE_Gb, 9728, 16 },
+    { MLX90632_EE_Ka, 10752, 16 },
+    { MLX90632_EE_Ha, 16384, 16 },
+    { MLX90632_EE_Hb, 0, 16 },
+};
+
+static int32_t fake_read(void *ctx, uint16_t reg, uint16_t *value){
+    fake.reads++;
+    if (fake.fail)
+        return -EIO;
+    *value = fake_regs[reg];
+    return 0;
+}
+
+static int32_t fake_read_block(void *ctx, uint16_t reg, uint16_t *value, uint16_t len){
+    fake.read_blocks++;
+    if (fake.fail || fake.block_fail)
+        return -EIO;
+    memcpy(value, &fake_regs[reg], (size_t)len * sizeof(*value));
+    return 0;
+}
+
+static int32_t fake_write(void *ctx, uint16_t reg, uint16_t value){
+    fake.writes++;
+    if (fake.fail)
+        return -EIO;
+
+    if ((reg >= 0x2400) && (reg <= 0x27FF)){
+        if (!fake.unlocked){
+            fake.ee_locked++;
+            return 0;
+        }
+        fake.unlocked = false;
+        fake.ee_writes++;
+        if ((fake.ee_writes <= 32) && (fake.ee_fail & (1u << (fake.ee_writes - 1))))
+            return -EIO;
+    } else if (reg == MLX90632_REG_CMD){
+        fake.unlocked = (value == MLX90632_EEPROM_WRITE_KEY);
+    } else if ((reg == MLX90632_REG_STATUS) && fake.ready_sticky){
+        value |= MLX90632_STAT_DATA_RDY;
+    } else if ((reg == MLX90632_REG_CTRL) && fake.ctrl_stuck){
+        return 0;
+    }
+
+    fake_regs[reg] = value;
+    return 0;
+}
+
+static void fake_sleep_us(void *ctx, uint32_t us){
+    fake.now_us += us;
+}
+
+static uint64_t fake_now_us(void *ctx){
+    return fake.now_us;
+}
+
+const MLXBus_s fake_bus = {
+    .read = fake_read,
+    .write = fake_write,
+    .read_block = fake_read_block,
+    .sleep_us = fake_sleep_us,
+    .now_us = fake_now_us,
+    .ctx = NULL,
+};
+
+void fake_bus_setup(void){
+    size_t i;
+
+    memset(fake_regs, 0, sizeof(fake_regs));
+    memset(&fake, 0, sizeof(fake));
+    fake.ready_sticky = true;
+
+    fake_regs[MLX90632_EE_VERSION] = MLX90632_DSPv5;
+    fake_regs[MLX90632_EE_I2C_ADDRESS] = MLX90632_I2C_ADDR >> 1;
+    fake_regs[MLX90632_EE_MEDICAL_MEAS1] = 0x820D;
+    fake_regs[MLX90632_EE_MEDICAL_MEAS2] = 0x82D2;
+    for (i = 0; i < sizeof(fake_calib) / sizeof(fake_calib[0]); i++){
+        fake_regs[fake_calib[i].addr] = (uint16_t)(fake_calib[i].value & 0xFFFF);
+        if (fake_calib[i].width == 32)
+            fake_regs[fake_calib[i].addr + 1] = (uint16_t)((uint32_t)fake_calib[i].value >> 16);
+    }
+
+    //ambient 25 degC and object 37 degC, cycle position 1 ready
+    fake_regs[MLX90632_RAM_1(1)] = 1149;
+    fake_regs[MLX90632_RAM_2(1)] = 1149;
+    fake_regs[MLX90632_RAM_3(1)] = 25658;
+    fake_regs[MLX90632_RAM_1(2)] = 1149;
+    fake_regs[MLX90632_RAM_2(2)] = 1149;
+    fake_regs[MLX90632_RAM_3(2)] = 30000;
+    fake_regs[MLX90632_REG_STATUS] = (1 << 2) | MLX90632_STAT_DATA_RDY;
+
+    mlx90632_bus_set(&fake_bus);
+}
+
+uint32_t fake_bus_transactions(void){
+    return fake.reads + fake.read_blocks + fake.writes;
+}
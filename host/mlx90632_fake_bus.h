@@ -0,0 +1,76 @@
+/******************************************************************************
+ * Copyright (c) 2025 Marconatale Parise.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * You may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************/
+/**
+ * @file mlx90632_fake_bus.h
+ * @brief in-memory register file of a medical sensor, used by the host benchmark and tests
+ *
+ * The register file holds the calibration of the Melexis example, ambient 25 degC and object
+ * 37 degC on cycle position 1 and 2. Sleeps move a simulated clock instead of sleeping, so
+ * polling and timeouts run at full speed and are deterministic.
+ *
+ * Eeprom words (0x2400..0x27FF) are only written after a MLX90632_EEPROM_WRITE_KEY unlock of
+ * MLX90632_REG_CMD, every write relocks, like the sensor. ee_fail makes chosen eeprom writes fail
+ * and leave the word as it was, e.g. only the program after an erase.
+ *
+ * The following functions will be implemented:
+ * - fake_bus_setup() to load the register file and install the bus
+ * - fake_bus_transactions() to get the bus transactions since setup
+ *
+ */
+
+#ifndef __MLX90632_FAKE_BUS_H__
+#define __MLX90632_FAKE_BUS_H__
+
+#include <stdbool.h>
+#include "mlx90632.h"
+
+typedef struct{
+    uint32_t reads;             /**< single word reads */
+    uint32_t read_blocks;       /**< block reads */
+    uint32_t writes;            /**< word writes, eeprom included */
+    uint32_t ee_writes;         /**< unlocked eeprom words erased or programmed, failed ones included */
+    uint32_t ee_locked;         /**< eeprom writes dropped without unlock */
+    uint64_t now_us;            /**< simulated clock, moved by sleeps only */
+    bool ready_sticky;          /**< status writes keep data ready set, every poll finds a cycle */
+    bool fail;                  /**< every transfer fails with -EIO */
+    bool block_fail;            /**< block reads fail with -EIO, word reads work */
+    bool ctrl_stuck;            /**< writes of MLX90632_REG_CTRL succeed but are dropped */
+    bool unlocked;              /**< next eeprom write accepted */
+    uint32_t ee_fail;           /**< bit n set: the n-th unlocked eeprom write (from 0) fails with -EIO */
+}MLXFakeBus_s;
+
+extern uint16_t fake_regs[0x10000];
+extern MLXFakeBus_s fake;
+extern const MLXBus_s fake_bus;
+
+/**
+ * @brief Load the register file of the medical sensor, reset counters and install the bus
+ *
+ * Data ready is set on cycle position 1 and ready_sticky is enabled.
+ *
+ * @return void
+ */
+void fake_bus_setup(void);
+
+/**
+ * @brief Get the bus transactions since fake_bus_setup()
+ *
+ * @return uint32_t reads, block reads and writes
+ */
+uint32_t fake_bus_transactions(void);
+
+#endif /* __MLX90632_FAKE_BUS_H__ */
@@ -0,0 +1,70 @@
+/******************************************************************************
+ * Copyright (c) 2025 Marconatale Parise.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * You may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************/
+/**
+ * @file mlx90632_stream_decode.c
+ * @brief host decoder of the binary sample stream
+ *
+ * Usage: mlx90632_stream_decode [file|/dev/ttyACMn]
+ *
+ * Reads the stream from the file, serial port (set up before with stty, e.g.
+ * `stty -F /dev/ttyACM0 115200 raw`) or stdin, prints one line per valid frame and at the end
+ * the frames decoded, CRC errors, frames lost by sequence number and bytes skipped.
+ * Console text between frames is skipped. Exit status is 1 if any frame was bad or lost.
+ *
+ */
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include "mlx90632_stream.h"
+
+static void stream_print(const MLXStreamRecord_s *rec){
+    printf("%u us sensor %u seq %u", rec->timestamp_us, rec->sensor_id, rec->seq);
+    if (rec->flags & MLX90632_STREAM_FLAG_TEMP)
+        printf(" ambient %.2f object %.2f", rec->ambient_centi / 100.0, rec->object_centi / 100.0);
+    if (rec->flags & MLX90632_STREAM_FLAG_RAW)
+        printf(" cycle %u raw %d %d %d %d", rec->cycle_pos, rec->raw.ambient_ram_6, rec->raw.ambient_ram_9,
+               rec->raw.object_ram_4_7, rec->raw.object_ram_5_8);
+    printf("\n");
+}
+
+int main(int argc, char **argv){
+    MLXStreamDecoder_s dec;
+    MLXStreamRecord_s rec;
+    FILE *in = stdin;
+    int c;
+
+    if (argc > 1){
+        in = fopen(argv[1], "rb");
+        if (in == NULL){
+            fprintf(stderr, "cannot open %s: %s\n", argv[1], strerror(errno));
+            return 1;
+        }
+    }
+
+    mlx90632_stream_decoder_init(&dec);
+    while ((c = fgetc(in)) != EOF){
+        if (mlx90632_stream_feed(&dec, (uint8_t)c, &rec))
+            stream_print(&rec);
+    }
+
+    fprintf(stderr, "%u frames, %u crc errors, %u lost, %u bytes skipped\n",
+            dec.frames, dec.crc_errors, dec.lost, dec.skipped);
+
+    if (in != stdin)
+        fclose(in);
+    return ((dec.crc_errors > 0) || (dec.lost > 0)) ? 1 : 0;
+}
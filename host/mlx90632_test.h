@@ -0,0 +1,67 @@
+/******************************************************************************
+ * Copyright (c) 2025 Marconatale Parise.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * You may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************/
+/**
+ * @file mlx90632_test.h
+ * @brief minimal checks of the host tests run by ctest
+ *
+ * A failed check prints file, line and expression and the test goes on, main() returns
+ * test_result() so ctest reports the executable as failed.
+ *
+ */
+
+#ifndef __MLX90632_TEST_H__
+#define __MLX90632_TEST_H__
+
+#include <stdio.h>
+#include <math.h>
+
+static int test_failures;
+
+#define TEST_CHECK(cond) do { \
+        if (!(cond)){ \
+            printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); \
+            test_failures++; \
+        } \
+    } while (0)
+
+#define TEST_CHECK_EQ(a, b) do { \
+        long long test_a_ = (long long)(a), test_b_ = (long long)(b); \
+        if (test_a_ != test_b_){ \
+            printf("%s:%d: check failed: %s == %s (%lld != %lld)\n", __FILE__, __LINE__, #a, #b, test_a_, test_b_); \
+            test_failures++; \
+        } \
+    } while (0)
+
+#define TEST_CHECK_NEAR(a, b, tol) do { \
+        double test_a_ = (double)(a), test_b_ = (double)(b); \
+        if (!(fabs(test_a_ - test_b_) <= (tol))){ \
+            printf("%s:%d: check failed: %s ~ %s (%.9g != %.9g)\n", __FILE__, __LINE__, #a, #b, test_a_, test_b_); \
+            test_failures++; \
+        } \
+    } while (0)
+
+#define TEST_RUN(fn) do { \
+        printf("-- %s\n", #fn); \
+        fn(); \
+    } while (0)
+
+static inline int test_result(void){
+    printf("%s: %d failed checks\n", (test_failures == 0) ? "PASS" : "FAIL", test_failures);
+    return (test_failures == 0) ? 0 : 1;
+}
+
+#endif /* __MLX90632_TEST_H__ */
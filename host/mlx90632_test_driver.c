@@ -0,0 +1,339 @@
+/******************************************************************************
+ * Copyright (c) 2025 Marconatale Parise.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * You may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************/
+/**
+ * @file mlx90632_test_driver.c
+ * @brief host tests of the driver state machine on the fake register bus
+ *
+ * Covers init with calibration decode (signed 16-bit constants included), sleeping step
+ * measurement polling and its timeout, burst measurement of the table, continuous mode data
+ * ready handling in medical and extended range, bus statistics accounted from two threads.
+ *
+ */
+#include <pthread.h>
+#include "mlx90632.h"
+#include "mlx90632_hal.h"
+#include "mlx90632_fake_bus.h"
+#include "mlx90632_test.h"
+
+static void test_init_calib(void){
+    fake_bus_setup();
+    TEST_CHECK_EQ(mlx90632_init(), 0);
+
+    //MEDICAL_MEAS1 0x820D holds refresh rate 2 (2 Hz)
+    TEST_CHECK_EQ(MLX_STS.refresh, 2);
+    TEST_CHECK_EQ(MLX_STS.conv_time_us, 500000);
+
+    TEST_CHECK_NEAR(MLX_K.P_R, 0x00587f5b / 256.0, 1e-6 * 0x00587f5b / 256.0);
+    TEST_CHECK_NEAR(MLX_K.P_G, 0x04a10289 / 1048576.0, 1e-6 * 0x04a10289 / 1048576.0);
+    TEST_CHECK_NEAR(MLX_K.P_T, ldexp((int32_t)0xfff966f8, -44), 1e-6 * ldexp(432392.0, -44));
+    TEST_CHECK_NEAR(MLX_K.P_O, 0x1e0f / 256.0, 1e-6);
+    TEST_CHECK_NEAR(MLX_K.Ea, 4859535 / 65536.0, 1e-4);
+    TEST_CHECK_NEAR(MLX_K.Eb, 5686508 / 256.0, 1e-2);
+    TEST_CHECK_NEAR(MLX_K.Fa, ldexp(53855361.0, -46), 1e-6 * ldexp(53855361.0, -46));
+    TEST_CHECK_NEAR(MLX_K.Fb, ldexp(42874149.0, -36), 1e-6 * ldexp(42874149.0, -36));
+    TEST_CHECK_NEAR(MLX_K.Ga, ldexp(-14556410.0, -36), 1e-6 * ldexp(14556410.0, -36));
+    TEST_CHECK_NEAR(MLX_K.Gb, 9728 / 1024.0, 1e-6);
+    TEST_CHECK_NEAR(MLX_K.Ka, 10752 / 1024.0, 1e-6);
+    TEST_CHECK_NEAR(MLX_K.Ha, 1.0, 1e-6);
+    TEST_CHECK_NEAR(MLX_K.Hb, 0.0, 1e-6);
+}
+
+static void test_calib_signed(void){
+    fake_bus_setup();
+    //16-bit constants are int16: 0xFC00 is -1024
+    fake_regs[MLX90632_EE_Gb] = 0xFC00;
+    fake_regs[MLX90632_EE_Ka] = 0xD600;
+    fake_regs[MLX90632_EE_Ha] = 0x8000;
+    fake_regs[MLX90632_EE_Hb] = 0xF000;
+    TEST_CHECK_EQ(mlx90632_init(), 0);
+
+    TEST_CHECK_NEAR(MLX_K.Gb, -1.0, 1e-6);
+    TEST_CHECK_NEAR(MLX_K.Ka, -10752 / 1024.0, 1e-6);
+    TEST_CHECK_NEAR(MLX_K.Ha, -2.0, 1e-6);
+    TEST_CHECK_NEAR(MLX_K.Hb, -0.25, 1e-6);
+}
+
+static void test_init_errors(void){
+    fake_bus_setup();
+    fake_regs[MLX90632_EE_VERSION] = 0x0004;
+    TEST_CHECK_EQ(mlx90632_init(), -EPROTONOSUPPORT);
+
+    fake_bus_setup();
+    fake_regs[MLX90632_EE_I2C_ADDRESS] = 0x1D + 1;
+    TEST_CHECK(mlx90632_init() < 0);
+
+    fake_bus_setup();
+    fake.fail = true;
+    TEST_CHECK(mlx90632_init() < 0);
+}
+
+static void test_readcalib_eeprom_busy(void){
+    fake_bus_setup();
+    fake_regs[MLX90632_REG_STATUS] |= MLX90632_STAT_EE_BUSY;
+    TEST_CHECK(i2c_melexis_e2busy());
+    TEST_CHECK_EQ(mlx90632_readCalib(), -ETIMEDOUT);
+    TEST_CHECK_EQ(fake.read_blocks, 0);
+    TEST_CHECK(fake.now_us >= MLX90632_TIMING_EEPROM * 1000ULL);
+
+    fake_regs[MLX90632_REG_STATUS] &= (uint16_t)~MLX90632_STAT_EE_BUSY;
+    TEST_CHECK(!i2c_melexis_e2busy());
+    TEST_CHECK_EQ(mlx90632_readCalib(), 0);
+
+    //calibration not read: init fails instead of preparing the kernel on it
+    fake_regs[MLX90632_REG_STATUS] |= MLX90632_STAT_EE_BUSY;
+    TEST_CHECK_EQ(mlx90632_init(), -ETIMEDOUT);
+
+    fake_regs[MLX90632_REG_STATUS] &= (uint16_t)~MLX90632_STAT_EE_BUSY;
+    fake.block_fail = true;
+    TEST_CHECK(mlx90632_init() < 0);
+}
+
+static void test_setmode(void){
+    uint16_t ctrl = MLX90632_MTYP_STATUS(MLX90632_MTYP_EXTENDED) | MLX90632_PWR_STATUS_STEP;
+
+    //measurement type bits kept
+    fake_bus_setup();
+    fake_regs[MLX90632_REG_CTRL] = ctrl;
+    TEST_CHECK_EQ(i2c_melexis_setmode(MLX90632_PWR_STATUS_SLEEP_STEP), 0);
+    TEST_CHECK_EQ(fake_regs[MLX90632_REG_CTRL], MLX90632_MTYP_STATUS(MLX90632_MTYP_EXTENDED) | MLX90632_PWR_STATUS_SLEEP_STEP);
+
+    //failed read: error returned, nothing written, not taken for the mode
+    fake_regs[MLX90632_REG_CTRL] = ctrl;
+    fake.fail = true;
+    TEST_CHECK(i2c_melexis_setmode(MLX90632_PWR_STATUS_SLEEP_STEP) < 0);
+    TEST_CHECK(i2c_melexis_setmode(MLX90632_PWR_STATUS_CONTINUOUS) < 0);
+    fake.fail = false;
+    TEST_CHECK_EQ(fake_regs[MLX90632_REG_CTRL], ctrl);
+
+    //mode bits that never change: bounded retries
+    fake.writes = 0;
+    fake.ctrl_stuck = true;
+    TEST_CHECK_EQ(i2c_melexis_setmode(MLX90632_PWR_STATUS_SLEEP_STEP), -ETIMEDOUT);
+    TEST_CHECK_EQ(fake.writes, MLX90632_MAX_NUMBER_MESUREMENT_READ_TRIES);
+    TEST_CHECK_EQ(fake_regs[MLX90632_REG_CTRL], ctrl);
+}
+
+static void test_start_measurement(void){
+    MLXPollStats_s poll;
+    uint64_t start;
+    int ret;
+
+    fake_bus_setup();
+    TEST_CHECK_EQ(mlx90632_init(), 0);
+    MLX_STS.comm_sts = true;
+
+    start = fake.now_us;
+    ret = mlx90632_start_measurement();
+    TEST_CHECK_EQ(ret, 1);
+    mlx90632_get_poll_stats(&poll);
+    TEST_CHECK_EQ(poll.last, 1);
+    //one sleep until just before data ready, no early polling
+    TEST_CHECK(fake.now_us - start >= MLX_STS.conv_time_us - MLX_STS.conv_time_us / MLX90632_WAKEUP_MARGIN_DIV);
+
+    fake_regs[MLX90632_REG_STATUS] = (2 << 2) | MLX90632_STAT_DATA_RDY;
+    TEST_CHECK_EQ(mlx90632_start_measurement(), 2);
+}
+
+static void test_start_measurement_timeout(void){
+    MLXPollStats_s poll;
+    int ret;
+
+    fake_bus_setup();
+    TEST_CHECK_EQ(mlx90632_init(), 0);
+    MLX_STS.comm_sts = true;
+    MLX_STS.count_check_meas = 0;
+    mlx90632_reset_poll_stats();
+
+    //data ready is cleared by the driver and never set again
+    fake.ready_sticky = false;
+    ret = mlx90632_start_measurement();
+    TEST_CHECK_EQ(ret, -ETIMEDOUT);
+    mlx90632_get_poll_stats(&poll);
+    TEST_CHECK_EQ(poll.last, MLX90632_MAX_NUMBER_MESUREMENT_READ_TRIES);
+    TEST_CHECK_EQ(poll.samples, 1);
+
+    mlx90632_checkTimeout(ret);
+    TEST_CHECK_EQ(MLX_STS.count_check_meas, 1);
+    mlx90632_checkTimeout(1);
+    TEST_CHECK_EQ(MLX_STS.count_check_meas, 0);
+}
+
+static uint32_t test_transactions(void){
+    uint32_t count = fake_bus_transactions();
+
+    fake.reads = 0;
+    fake.read_blocks = 0;
+    fake.writes = 0;
+    return count;
+}
+
+static void test_read_burst(void){
+    MLXBurst_s burst;
+    MLXTempRaw_s raw;
+    int cycle_pos, i;
+
+    fake_bus_setup();
+    TEST_CHECK_EQ(mlx90632_init(), 0);
+    MLX_STS.comm_sts = true;
+
+    //one SOB: both positions of the table from one RAM read
+    test_transactions();
+    TEST_CHECK_EQ(mlx90632_read_burst(&burst), 2);
+    TEST_CHECK_EQ(test_transactions(), 5);
+    TEST_CHECK_EQ(burst.count, 2);
+    for (i = 0; i < 2; i++){
+        TEST_CHECK_EQ(burst.cycle_pos[i], i + 1);
+        TEST_CHECK_EQ(burst.raw[i].ambient_ram_6, 25658);
+        TEST_CHECK_EQ(burst.raw[i].ambient_ram_9, 30000);
+        TEST_CHECK_EQ(burst.raw[i].object_ram_4_7, 1149);
+    }
+
+    //the same two samples with one SOC each
+    for (i = 0; i < 2; i++){
+        cycle_pos = mlx90632_start_measurement();
+        TEST_CHECK(cycle_pos > 0);
+        TEST_CHECK_EQ(mlx90632_readTempRaw(cycle_pos, &raw), 0);
+    }
+    TEST_CHECK_EQ(test_transactions(), 14);
+}
+
+static void test_wait_continuous(void){
+    fake_bus_setup();
+    TEST_CHECK_EQ(mlx90632_init(), 0);
+    MLX_STS.comm_sts = true;
+    fake.ready_sticky = false;
+
+    //data ready left from init is dropped, no new data yet
+    TEST_CHECK_EQ(mlx90632_start_continuous(), 0);
+    TEST_CHECK(!(fake_regs[MLX90632_REG_STATUS] & MLX90632_STAT_DATA_RDY));
+    TEST_CHECK_EQ(mlx90632_wait_continuous(), -ETIMEDOUT);
+
+    fake_regs[MLX90632_REG_STATUS] = (1 << 2) | MLX90632_STAT_DATA_RDY;
+    TEST_CHECK_EQ(mlx90632_wait_continuous(), 1);
+    TEST_CHECK_EQ(MLX_T_RAW.ambient_ram_6, 25658);
+    TEST_CHECK_EQ(MLX_T_RAW.ambient_ram_9, 30000);
+    //cleared after the RAM read
+    TEST_CHECK(!(fake_regs[MLX90632_REG_STATUS] & MLX90632_STAT_DATA_RDY));
+
+    //same position again (position 2 missed): still a new sample
+    fake_regs[MLX90632_RAM_1(1)] = 2000;
+    fake_regs[MLX90632_REG_STATUS] = (1 << 2) | MLX90632_STAT_DATA_RDY;
+    TEST_CHECK_EQ(mlx90632_wait_continuous(), 1);
+    TEST_CHECK_EQ(MLX_T_RAW.object_ram_4_7, 2000);
+
+    //position moved without data ready: not a sample
+    fake_regs[MLX90632_REG_STATUS] = (2 << 2);
+    TEST_CHECK_EQ(mlx90632_wait_continuous(), -ETIMEDOUT);
+
+    fake_regs[MLX90632_REG_STATUS] = (2 << 2) | MLX90632_STAT_DATA_RDY;
+    TEST_CHECK_EQ(mlx90632_wait_continuous(), 2);
+    TEST_CHECK_EQ(mlx90632_stop_continuous(), 0);
+}
+
+static void test_wait_continuous_extended(void){
+    fake_bus_setup();
+    TEST_CHECK_EQ(mlx90632_init(), 0);
+    MLX_STS.comm_sts = true;
+    MLX_STS.meas_type = MLX90632_MTYP_EXTENDED;
+    fake.ready_sticky = false;
+
+    fake_regs[MLX90632_RAM_1(17)] = 300;
+    fake_regs[MLX90632_RAM_2(17)] = 100;
+    fake_regs[MLX90632_RAM_3(17)] = 25658;
+    fake_regs[MLX90632_RAM_1(18)] = 100;
+    fake_regs[MLX90632_RAM_2(18)] = 100;
+    fake_regs[MLX90632_RAM_3(18)] = 30000;
+    fake_regs[MLX90632_RAM_1(19)] = 50;
+    fake_regs[MLX90632_RAM_2(19)] = 50;
+    TEST_CHECK_EQ(mlx90632_start_continuous(), 0);
+
+    //positions 17 and 18 are not a sample of the extended table
+    fake_regs[MLX90632_REG_STATUS] = (18 << 2) | MLX90632_STAT_DATA_RDY;
+    TEST_CHECK_EQ(mlx90632_wait_continuous(), -ETIMEDOUT);
+
+    fake.now_us = 0;
+    fake_regs[MLX90632_REG_STATUS] = (MLX90632_EXTENDED_LAST_POS << 2) | MLX90632_STAT_DATA_RDY;
+    MLX_STS.last_ready_us = 0;
+    TEST_CHECK_EQ(mlx90632_wait_continuous(), MLX90632_EXTENDED_LAST_POS);
+    //slept for the whole table before polling
+    TEST_CHECK(fake.now_us >= (uint64_t)MLX_STS.conv_time_us * (MLX90632_EXTENDED_TABLE_LEN - 1));
+    TEST_CHECK_EQ(MLX_T_RAW.ambient_ram_6, 25658);
+    TEST_CHECK_EQ(MLX_T_RAW.ambient_ram_9, 30000);
+    TEST_CHECK_EQ(MLX_T_RAW.object_ram_4_7, 200);
+    TEST_CHECK_EQ(MLX_T_RAW.object_ram_5_8, 200);
+    TEST_CHECK(!(fake_regs[MLX90632_REG_STATUS] & MLX90632_STAT_DATA_RDY));
+
+    TEST_CHECK_EQ(mlx90632_stop_continuous(), 0);
+    MLX_STS.meas_type = MLX90632_MTYP_MEDICAL;
+}
+
+#define STATS_READS 2000000
+
+static void *stats_reader(void *arg){
+    uint16_t value;
+    int i;
+
+    for (i = 0; i < STATS_READS; i++)
+        mlx90632_i2c_read(MLX90632_RAM_1(0), &value);
+    return NULL;
+}
+
+static void test_bus_stats_threads(void){
+    const MLXBusClassStats_s *ram;
+    MLXBusStats_s stats;
+    pthread_t reader[2];
+    uint32_t hist;
+    int i, b, torn = 0;
+
+    fake_bus_setup();
+    mlx90632_i2c_reset_stats();
+    for (i = 0; i < 2; i++)
+        TEST_CHECK_EQ(pthread_create(&reader[i], NULL, stats_reader, NULL), 0);
+
+    //snapshots taken while both threads account: every counter of one read or none
+    for (i = 0; i < STATS_READS; i++){
+        mlx90632_i2c_get_stats(&stats);
+        ram = &stats.cls[MLX90632_REG_CLASS_RAM];
+        for (hist = 0, b = 0; b < MLX90632_BUS_HIST_BUCKETS; b++)
+            hist += ram->hist[b];
+        if ((ram->bytes != 4U * ram->reads) || (hist != ram->reads))
+            torn++;
+    }
+    for (i = 0; i < 2; i++)
+        pthread_join(reader[i], NULL);
+    TEST_CHECK_EQ(torn, 0);
+
+    //no increment lost between the two threads
+    mlx90632_i2c_get_stats(&stats);
+    TEST_CHECK_EQ(stats.cls[MLX90632_REG_CLASS_RAM].reads, 2 * STATS_READS);
+    TEST_CHECK_EQ(stats.cls[MLX90632_REG_CLASS_RAM].bytes, 8 * STATS_READS);
+}
+
+int main(void){
+    TEST_RUN(test_init_calib);
+    TEST_RUN(test_calib_signed);
+    TEST_RUN(test_init_errors);
+    TEST_RUN(test_readcalib_eeprom_busy);
+    TEST_RUN(test_setmode);
+    TEST_RUN(test_start_measurement);
+    TEST_RUN(test_start_measurement_timeout);
+    TEST_RUN(test_read_burst);
+    TEST_RUN(test_wait_continuous);
+    TEST_RUN(test_wait_continuous_extended);
+    TEST_RUN(test_bus_stats_threads);
+    return test_result();
+}
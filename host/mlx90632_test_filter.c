@@ -0,0 +1,141 @@
+/******************************************************************************
+ * Copyright (c) 2025 Marconatale Parise.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * You may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************/
+/**
+ * @file mlx90632_test_filter.c
+ * @brief host tests of the filter stage
+ *
+ * The noise test filters an object at 36.6 degC with gaussian noise of 0.06 degC sd (sum of 12
+ * uniforms) and a 2 degC spike every 97 samples, and checks the rms error of each filter.
+ *
+ */
+#include "mlx90632_filter.h"
+#include "mlx90632_test.h"
+
+#define NOISE_SAMPLES   20000
+#define NOISE_SETTLE    100     /**< samples left out of the rms while the filters start */
+#define NOISE_OBJECT    36.6
+
+static uint32_t noise_state;
+
+/* Same sequence on every host, unlike rand() */
+static double noise_uniform(void){
+    noise_state = noise_state * 1664525U + 1013904223U;
+    return (noise_state >> 8) / 16777216.0;
+}
+
+static double noise_sample(int i){
+    double n = 0.0;
+    int k;
+
+    for (k = 0; k < 12; k++)
+        n += noise_uniform();
+    n = (n - 6.0) * 0.06;
+    if (i % 97 == 0)
+        n += 2.0;
+    return n;
+}
+
+static double noise_rms(mlx90632_filter_t type){
+    MLXFilterConfig_s cfg = {
+        .type = type,
+        .ema_alpha = MLX90632_FILTER_EMA_ALPHA,
+        .median_len = MLX90632_FILTER_MEDIAN_LEN,
+        .kalman_q = MLX90632_FILTER_KALMAN_Q,
+        .kalman_r = MLX90632_FILTER_KALMAN_R,
+    };
+    MLXFilter_s filter;
+    MLXTemp_s temp;
+    double err, sum = 0.0;
+    int i;
+
+    mlx90632_filter_init(&filter, &cfg);
+    noise_state = 3;
+    for (i = 0; i < NOISE_SAMPLES; i++){
+        temp.ambient = 25.0;
+        temp.object = NOISE_OBJECT + noise_sample(i);
+        mlx90632_filter_apply(&filter, &temp);
+        err = temp.object - NOISE_OBJECT;
+        if (i >= NOISE_SETTLE)
+            sum += err * err;
+    }
+    return sqrt(sum / (NOISE_SAMPLES - NOISE_SETTLE));
+}
+
+static void test_filter_noise(void){
+    double none, ema, median, kalman;
+
+    none = noise_rms(MLX90632_FILTER_NONE);
+    ema = noise_rms(MLX90632_FILTER_EMA);
+    median = noise_rms(MLX90632_FILTER_MEDIAN);
+    kalman = noise_rms(MLX90632_FILTER_KALMAN);
+    printf("rms error: none %.4f ema %.4f median %.4f kalman %.4f degC\n", none, ema, median, kalman);
+
+    TEST_CHECK_NEAR(none, 0.21, 0.02);
+    TEST_CHECK(ema < 0.09);
+    TEST_CHECK(median < 0.04);
+    TEST_CHECK(kalman < 0.07);
+}
+
+static void test_filter_start(void){
+    MLXFilterConfig_s cfg = {
+        .type = MLX90632_FILTER_EMA,
+        .ema_alpha = 0.5f,
+    };
+    MLXFilter_s filter;
+    MLXTemp_s temp = {.ambient = 25.0, .object = 30.0};
+
+    //first sample passes through, the next ones are averaged
+    mlx90632_filter_init(&filter, &cfg);
+    mlx90632_filter_apply(&filter, &temp);
+    TEST_CHECK_NEAR(temp.object, 30.0, 1e-6);
+    temp.object = 40.0;
+    mlx90632_filter_apply(&filter, &temp);
+    TEST_CHECK_NEAR(temp.object, 35.0, 1e-5);
+
+    //after reset the old value does not leak in the new one
+    mlx90632_filter_reset(&filter);
+    temp.object = 20.0;
+    mlx90632_filter_apply(&filter, &temp);
+    TEST_CHECK_NEAR(temp.object, 20.0, 1e-6);
+}
+
+static void test_filter_median_spike(void){
+    MLXFilterConfig_s cfg = {
+        .type = MLX90632_FILTER_MEDIAN,
+        .median_len = 4,    //rounded down to 3
+    };
+    MLXFilter_s filter;
+    MLXTemp_s temp;
+    static const double in[] = {30.0, 30.0, 80.0, 30.0, 30.0};
+    size_t i;
+
+    mlx90632_filter_init(&filter, &cfg);
+    TEST_CHECK_EQ(filter.cfg.median_len, 3);
+    for (i = 0; i < ARRAY_SIZE(in); i++){
+        temp.ambient = 25.0;
+        temp.object = in[i];
+        mlx90632_filter_apply(&filter, &temp);
+        TEST_CHECK_NEAR(temp.object, 30.0, 1e-6);
+    }
+}
+
+int main(void){
+    TEST_RUN(test_filter_start);
+    TEST_RUN(test_filter_median_spike);
+    TEST_RUN(test_filter_noise);
+    return test_result();
+}
@@ -0,0 +1,138 @@
+/******************************************************************************
+ * Copyright (c) 2025 Marconatale Parise.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * You may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************/
+/**
+ * @file mlx90632_test_kernel.c
+ * @brief host tests of the temperature kernels and of the warm-started solver
+ *
+ * The calibration is the one of the fake register bus, decoded by mlx90632_init().
+ *
+ */
+#include <pthread.h>
+#include "mlx90632.h"
+#include "mlx90632_kernel.h"
+#include "mlx90632_fake_bus.h"
+#include "mlx90632_test.h"
+
+static const MLXTempRaw_s raw_37 = {
+    .ambient_ram_6 = 25658, .ambient_ram_9 = 30000, .object_ram_4_7 = 1149, .object_ram_5_8 = 1149,
+};
+
+static void test_solver_tolerance(void){
+    MLXSolver_s solver, exact;
+    MLXTemp_s temp, ref;
+    MLXSolverStats_s stats;
+
+    //fixed point of the iteration, to the last bits
+    mlx90632_solver_init(&exact, 1e-12, MLX90632_SOLVER_MAX_ITER);
+    mlx90632_calc_temp_warm(&raw_37, &MLX_KP, &exact, &ref);
+    TEST_CHECK_NEAR(ref.object, 37.0, 0.5);
+
+    //cold start from 25 degC: stops on the change between iterations
+    mlx90632_solver_init(&solver, MLX_SOLVER_TOLERANCE, MLX90632_SOLVER_MAX_ITER);
+    mlx90632_calc_temp_warm(&raw_37, &MLX_KP, &solver, &temp);
+    TEST_CHECK_NEAR(temp.object, ref.object, MLX_SOLVER_TOLERANCE);
+    TEST_CHECK_NEAR(temp.ambient, ref.ambient, 1e-12);
+
+    mlx90632_solver_get_stats(&solver, &stats);
+    TEST_CHECK_EQ(stats.samples, 1);
+    TEST_CHECK(stats.max >= 2);
+    TEST_CHECK(stats.max < MLX90632_SOLVER_MAX_ITER);
+    TEST_CHECK_EQ(stats.hist[stats.max], 1);
+    TEST_CHECK_EQ(stats.limit_reached, 0);
+
+    //warm start on the same sample: the first change is already below the tolerance
+    mlx90632_calc_temp_warm(&raw_37, &MLX_KP, &solver, &temp);
+    mlx90632_solver_get_stats(&solver, &stats);
+    TEST_CHECK_EQ(stats.hist[1], 1);
+    TEST_CHECK_NEAR(temp.object, ref.object, MLX_SOLVER_TOLERANCE);
+}
+
+static void test_solver_limit(void){
+    MLXSolver_s solver;
+    MLXTemp_s temp;
+    MLXSolverStats_s stats;
+
+    //cold start with one iteration: 12 degC away, stopped by the limit
+    mlx90632_solver_init(&solver, MLX_SOLVER_TOLERANCE, 1);
+    mlx90632_calc_temp_warm(&raw_37, &MLX_KP, &solver, &temp);
+    mlx90632_solver_get_stats(&solver, &stats);
+    TEST_CHECK_EQ(stats.hist[1], 1);
+    TEST_CHECK_EQ(stats.limit_reached, 1);
+
+    //converged seed: the only allowed iteration reaches the tolerance, not a limit stop
+    solver.max_iter = MLX90632_SOLVER_MAX_ITER;
+    mlx90632_calc_temp_warm(&raw_37, &MLX_KP, &solver, &temp);
+    solver.max_iter = 1;
+    mlx90632_solver_reset_stats(&solver);
+    mlx90632_calc_temp_warm(&raw_37, &MLX_KP, &solver, &temp);
+    mlx90632_solver_get_stats(&solver, &stats);
+    TEST_CHECK_EQ(stats.samples, 1);
+    TEST_CHECK_EQ(stats.hist[1], 1);
+    TEST_CHECK_EQ(stats.limit_reached, 0);
+}
+
+#define SNAPSHOT_READS  2000000
+
+static atomic_bool snapshot_stop;
+static atomic_int snapshot_writes;
+
+/* Rebuild MLX_KP with alternating emissivity, as an i2c recovery or an emissivity change does */
+static void *snapshot_writer(void *arg){
+    int i = 0;
+
+    while (!atomic_load(&snapshot_stop)){
+        mlx90632_set_emissivity((i++ & 1) ? 0.5 : 1.0);
+        atomic_fetch_add(&snapshot_writes, 1);
+    }
+    return NULL;
+}
+
+static void test_snapshot_consistent(void){
+    MLXPrepared_s prep;
+    pthread_t writer;
+    int i, torn = 0;
+
+    atomic_store(&snapshot_stop, false);
+    atomic_store(&snapshot_writes, 0);
+    TEST_CHECK_EQ(pthread_create(&writer, NULL, snapshot_writer, NULL), 0);
+    for (i = 0; i < SNAPSHOT_READS; i++){
+        mlx90632_kernel_snapshot(&prep);
+        //the double, float and Q constants of one snapshot come from the same emissivity
+        if ((prep.f.inv_emiFaHa != (float)prep.d.inv_emiFaHa) ||
+            (prep.q.K_q8 != llround(ldexp(prep.d.inv_emiFaHa, 8))))
+            torn++;
+    }
+    atomic_store(&snapshot_stop, true);
+    pthread_join(writer, NULL);
+    TEST_CHECK(atomic_load(&snapshot_writes) > 0);
+    TEST_CHECK_EQ(torn, 0);
+
+    mlx90632_set_emissivity(1.0);
+}
+
+int main(void){
+    fake_bus_setup();
+    if (mlx90632_init() < 0){
+        printf("init on the fake bus failed\n");
+        return 1;
+    }
+
+    TEST_RUN(test_solver_tolerance);
+    TEST_RUN(test_solver_limit);
+    TEST_RUN(test_snapshot_consistent);
+    return test_result();
+}
@@ -0,0 +1,182 @@
+/******************************************************************************
+ * Copyright (c) 2025 Marconatale Parise.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * You may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************/
+/**
+ * @file mlx90632_test_kernel_sweep.c
+ * @brief sweep of the float32 and Q kernels against the double reference
+ *
+ * RAM_6, RAM_9 and the object words (RAM_4/7 = RAM_5/8) run over the whole int16 range with a
+ * step of SWEEP_STEP. Records with a reference ambient in -40..85 degC are kept for the ambient
+ * kernels, and those with a reference object in -70..380 degC for the object kernels. The max
+ * error of each kernel is checked against the bounds of mlx90632_kernel.h, and each kernel is
+ * timed over the kept records, in ns and, on x86, in TSC cycles per call.
+ *
+ * The calibration is the one of the fake register bus, decoded by mlx90632_init().
+ *
+ */
+#include <stdlib.h>
+#include <time.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define SWEEP_CYCLES() __rdtsc()
+#else
+#define SWEEP_CYCLES() 0ULL
+#endif
+#include "mlx90632.h"
+#include "mlx90632_kernel.h"
+#include "mlx90632_fake_bus.h"
+#include "mlx90632_test.h"
+
+#define SWEEP_STEP      509
+#define SWEEP_AMB_MIN   -40.0
+#define SWEEP_AMB_MAX   85.0
+#define SWEEP_OBJ_MIN   -70.0
+#define SWEEP_OBJ_MAX   380.0
+
+typedef struct{
+    MLXTempRaw_s *raw;
+    double *ref;
+    double *out;
+    size_t count;
+    size_t size;
+}SweepSet_s;
+
+typedef enum{
+    SWEEP_AMB_F,
+    SWEEP_AMB_Q,
+    SWEEP_OBJ_F,
+    SWEEP_OBJ_Q,
+}SweepKernel_t;
+
+static SweepSet_s amb_set, obj_set;
+
+static void sweep_push(SweepSet_s *set, const MLXTempRaw_s *raw, double ref){
+    if (set->count == set->size){
+        set->size = set->size ? 2 * set->size : 1024;
+        set->raw = realloc(set->raw, set->size * sizeof(*set->raw));
+        set->ref = realloc(set->ref, set->size * sizeof(*set->ref));
+        set->out = realloc(set->out, set->size * sizeof(*set->out));
+        if ((set->raw == NULL) || (set->ref == NULL) || (set->out == NULL)){
+            printf("out of memory\n");
+            exit(1);
+        }
+    }
+    set->raw[set->count] = *raw;
+    set->ref[set->count] = ref;
+    set->count++;
+}
+
+static void sweep_build(void){
+    MLXTempRaw_s raw;
+    double ref;
+    int ram6, ram9, obj;
+
+    for (ram6 = INT16_MIN; ram6 <= INT16_MAX; ram6 += SWEEP_STEP){
+        for (ram9 = INT16_MIN; ram9 <= INT16_MAX; ram9 += SWEEP_STEP){
+            raw.ambient_ram_6 = (int16_t)ram6;
+            raw.ambient_ram_9 = (int16_t)ram9;
+            raw.object_ram_4_7 = 0;
+            raw.object_ram_5_8 = 0;
+            ref = mlx90632_calc_temp_ambient_raw(&raw, MLX_K.Gb, MLX_K.P_O, MLX_K.P_R, MLX_K.P_G, MLX_K.P_T);
+            if (!(ref >= SWEEP_AMB_MIN) || !(ref <= SWEEP_AMB_MAX))
+                continue;
+            sweep_push(&amb_set, &raw, ref);
+
+            for (obj = INT16_MIN; obj <= INT16_MAX; obj += SWEEP_STEP){
+                raw.object_ram_4_7 = (int16_t)obj;
+                raw.object_ram_5_8 = (int16_t)obj;
+                ref = mlx90632_calc_temp_object_raw(&raw, MLX_K.Ka, MLX_K.Gb, MLX_K.Ea, MLX_K.Eb, MLX_K.Fa,
+                                                    MLX_K.Ha, MLX_K.Ga, MLX_K.Fb, MLX_K.Hb);
+                if (!(ref >= SWEEP_OBJ_MIN) || !(ref <= SWEEP_OBJ_MAX))
+                    continue;
+                sweep_push(&obj_set, &raw, ref);
+            }
+        }
+    }
+}
+
+static uint64_t sweep_now_ns(void){
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+/* Run one kernel over the set, results in set->out in degC, return the max error */
+static double sweep_run(SweepSet_s *set, SweepKernel_t kernel, const char *name, double bound){
+    uint64_t ns, cycles;
+    double err, max_err = 0.0;
+    size_t i;
+
+    ns = sweep_now_ns();
+    cycles = SWEEP_CYCLES();
+    for (i = 0; i < set->count; i++){
+        switch (kernel){
+        case SWEEP_AMB_F:
+            set->out[i] = mlx90632_calc_temp_ambient_f(&set->raw[i], &MLX_KP);
+            break;
+        case SWEEP_AMB_Q:
+            set->out[i] = mlx90632_calc_temp_ambient_q(&set->raw[i], &MLX_KP) / 1000.0;
+            break;
+        case SWEEP_OBJ_F:
+            set->out[i] = mlx90632_calc_temp_object_f(&set->raw[i], &MLX_KP);
+            break;
+        case SWEEP_OBJ_Q:
+            set->out[i] = mlx90632_calc_temp_object_q(&set->raw[i], &MLX_KP) / 1000.0;
+            break;
+        }
+    }
+    cycles = SWEEP_CYCLES() - cycles;
+    ns = sweep_now_ns() - ns;
+
+    for (i = 0; i < set->count; i++){
+        err = fabs(set->out[i] - set->ref[i]);
+        if (!(err <= max_err))
+            max_err = err;
+    }
+
+    printf("%-10s n %zu max err %.6f degC (bound %.3f) %.1f ns/call", name, set->count, max_err, bound,
+           (double)ns / set->count);
+    if (cycles)
+        printf(" %.0f cycles/call", (double)cycles / set->count);
+    printf("\n");
+    return max_err;
+}
+
+static void test_sweep_ambient(void){
+    TEST_CHECK(amb_set.count > 0);
+    TEST_CHECK(sweep_run(&amb_set, SWEEP_AMB_F, "ambient_f", MLX90632_KERNEL_F_AMB_ERR) <= MLX90632_KERNEL_F_AMB_ERR);
+    TEST_CHECK(sweep_run(&amb_set, SWEEP_AMB_Q, "ambient_q", MLX90632_KERNEL_Q_AMB_ERR) <= MLX90632_KERNEL_Q_AMB_ERR);
+}
+
+static void test_sweep_object(void){
+    TEST_CHECK(obj_set.count > 0);
+    TEST_CHECK(sweep_run(&obj_set, SWEEP_OBJ_F, "object_f", MLX90632_KERNEL_F_OBJ_ERR) <= MLX90632_KERNEL_F_OBJ_ERR);
+    TEST_CHECK(sweep_run(&obj_set, SWEEP_OBJ_Q, "object_q", MLX90632_KERNEL_Q_OBJ_ERR) <= MLX90632_KERNEL_Q_OBJ_ERR);
+}
+
+int main(void){
+    fake_bus_setup();
+    if (mlx90632_init() < 0){
+        printf("init on the fake bus failed\n");
+        return 1;
+    }
+
+    sweep_build();
+    TEST_RUN(test_sweep_ambient);
+    TEST_RUN(test_sweep_object);
+    return test_result();
+}
@@ -0,0 +1,200 @@
+/******************************************************************************
+ * Copyright (c) 2025 Marconatale Parise.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * You may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************/
+/**
+ * @file mlx90632_test_rate.c
+ * @brief host tests of the refresh rate EEPROM write and of the adaptive rate controller
+ *
+ * mlx90632_set_refresh_rate() runs on the EEPROM model of the fake register bus: a word is
+ * only written after an unlock, each write erases or programs one word.
+ *
+ */
+#include "mlx90632.h"
+#include "mlx90632_rate.h"
+#include "mlx90632_fake_bus.h"
+#include "mlx90632_test.h"
+
+#define RATE_OBJECT 30.0
+
+static void test_set_refresh_rate(void){
+    fake_bus_setup();
+    TEST_CHECK_EQ(mlx90632_init(), 0);
+    TEST_CHECK_EQ(MLX_STS.refresh, MLX90632_MEAS_HZ_2);
+
+    //MEAS1 and MEAS2 erased then programmed, each after its own unlock
+    TEST_CHECK_EQ(mlx90632_set_refresh_rate(MLX90632_MEAS_HZ_4), 1);
+    TEST_CHECK_EQ(fake.ee_writes, 4);
+    TEST_CHECK_EQ(fake.ee_locked, 0);
+    TEST_CHECK_EQ((fake_regs[MLX90632_EE_MEDICAL_MEAS1] >> MLX90632_EE_REFRESH_RATE_SHIFT) & 0x7, MLX90632_MEAS_HZ_4);
+    TEST_CHECK_EQ((fake_regs[MLX90632_EE_MEDICAL_MEAS2] >> MLX90632_EE_REFRESH_RATE_SHIFT) & 0x7, MLX90632_MEAS_HZ_4);
+    TEST_CHECK_EQ(MLX_STS.refresh, MLX90632_MEAS_HZ_4);
+    TEST_CHECK_EQ(MLX_STS.conv_time_us, 250000);
+
+    //same rate: no EEPROM write at all
+    TEST_CHECK_EQ(mlx90632_set_refresh_rate(MLX90632_MEAS_HZ_4), 0);
+    TEST_CHECK_EQ(fake.ee_writes, 4);
+
+    TEST_CHECK_EQ(mlx90632_set_refresh_rate(MLX90632_MEAS_HZ_ERROR), -EINVAL);
+    TEST_CHECK_EQ(mlx90632_set_refresh_rate((mlx90632_meas_t)(MLX90632_MEAS_HZ_64 + 1)), -EINVAL);
+    TEST_CHECK_EQ(fake.ee_writes, 4);
+
+    //failed write: the rate in use is kept for mlx90632_rate_sync()
+    fake.fail = true;
+    TEST_CHECK(mlx90632_set_refresh_rate(MLX90632_MEAS_HZ_8) < 0);
+    fake.fail = false;
+    TEST_CHECK_EQ(MLX_STS.refresh, MLX90632_MEAS_HZ_4);
+
+    //stale rate after a failed read: refreshed even when nothing is written
+    MLX_STS.refresh = (uint8_t)MLX90632_MEAS_HZ_ERROR;
+    TEST_CHECK_EQ(mlx90632_set_refresh_rate(MLX90632_MEAS_HZ_4), 0);
+    TEST_CHECK_EQ(MLX_STS.refresh, MLX90632_MEAS_HZ_4);
+    TEST_CHECK_EQ(MLX_STS.conv_time_us, 250000);
+}
+
+/* Unlocked eeprom writes are counted from 0: erase and program of MEAS1, then of MEAS2 */
+static void test_set_refresh_rate_restore(void){
+    uint16_t meas1, meas2;
+    int32_t ret;
+
+    fake_bus_setup();
+    TEST_CHECK_EQ(mlx90632_init(), 0);
+    meas1 = fake_regs[MLX90632_EE_MEDICAL_MEAS1];
+    meas2 = fake_regs[MLX90632_EE_MEDICAL_MEAS2];
+
+    //program of MEAS1 fails after the erase: old value programmed back, MEAS2 not touched
+    fake.ee_writes = 0;
+    fake.ee_fail = BIT(1);
+    ret = mlx90632_set_refresh_rate(MLX90632_MEAS_HZ_4);
+    TEST_CHECK((ret < 0) && (ret != -EFAULT));
+    TEST_CHECK_EQ(fake.ee_writes, 4);
+    TEST_CHECK_EQ(fake_regs[MLX90632_EE_MEDICAL_MEAS1], meas1);
+    TEST_CHECK_EQ(fake_regs[MLX90632_EE_MEDICAL_MEAS2], meas2);
+    TEST_CHECK_EQ(MLX_STS.refresh, MLX90632_MEAS_HZ_2);
+
+    //program of MEAS2 fails: MEAS2 restored and MEAS1 written back to the old rate
+    fake.ee_writes = 0;
+    fake.ee_fail = BIT(3);
+    ret = mlx90632_set_refresh_rate(MLX90632_MEAS_HZ_4);
+    TEST_CHECK((ret < 0) && (ret != -EFAULT));
+    TEST_CHECK_EQ(fake.ee_writes, 8);
+    TEST_CHECK_EQ(fake_regs[MLX90632_EE_MEDICAL_MEAS1], meas1);
+    TEST_CHECK_EQ(fake_regs[MLX90632_EE_MEDICAL_MEAS2], meas2);
+    TEST_CHECK_EQ(MLX_STS.refresh, MLX90632_MEAS_HZ_2);
+
+    //every write after the first erase fails: bounded restore, erased word reported
+    fake.ee_writes = 0;
+    fake.ee_fail = ~1u;
+    TEST_CHECK_EQ(mlx90632_set_refresh_rate(MLX90632_MEAS_HZ_4), -EFAULT);
+    TEST_CHECK_EQ(fake.ee_writes, 2 + MLX90632_EEPROM_RESTORE_TRIES);
+    TEST_CHECK_EQ(fake_regs[MLX90632_EE_MEDICAL_MEAS1], 0x0000);
+    TEST_CHECK_EQ(MLX_STS.refresh, MLX90632_MEAS_HZ_2);
+}
+
+/* One window of object temperature, at the end of window w */
+static mlx90632_meas_t rate_window(MLXRate_s *rc, uint32_t w, double object){
+    return mlx90632_rate_update(rc, object, w * MLX90632_RATE_WINDOW_MS);
+}
+
+static void test_rate_min_change(void){
+    MLXRate_s rc;
+    MLXRateStats_s stats;
+    double object = RATE_OBJECT;
+    uint32_t w;
+
+    mlx90632_rate_init(&rc, NULL, MLX90632_MEAS_HZ_2);
+    rate_window(&rc, 0, object);
+
+    //a fast event right after start waits for the minimum interval, then jumps to max rate
+    for (w = 1; w * MLX90632_RATE_WINDOW_MS < MLX90632_RATE_MIN_CHANGE_MS; w++){
+        object += 1.0;
+        TEST_CHECK_EQ(rate_window(&rc, w, object), MLX90632_MEAS_HZ_2);
+    }
+    object += 1.0;
+    TEST_CHECK_EQ(rate_window(&rc, w, object), MLX90632_MEAS_HZ_8);
+
+    mlx90632_rate_get_stats(&rc, &stats);
+    TEST_CHECK_EQ(stats.ups, 1);
+    TEST_CHECK_EQ(stats.blocked, w - 1);
+}
+
+static void test_rate_budget(void){
+    const MLXRateConfig_s cfg = {
+        .min_rate = MLX90632_MEAS_HZ_1,
+        .max_rate = MLX90632_MEAS_HZ_8,
+        .window_ms = MLX90632_RATE_WINDOW_MS,
+        .up_milli_per_s = MLX90632_RATE_UP_MILLI,
+        .down_milli_per_s = MLX90632_RATE_DOWN_MILLI,
+        .calm_windows = 1,
+        .hold_ms = 0,
+        .min_change_ms = 0,
+        .max_changes = 3,
+    };
+    MLXRate_s rc;
+    MLXRateStats_s stats;
+    double object = RATE_OBJECT;
+    uint32_t w = 0;
+
+    mlx90632_rate_init(&rc, &cfg, MLX90632_MEAS_HZ_1);
+    rate_window(&rc, w++, object);
+
+    //up, down, up: the budget of 3 changes is spent
+    object += 1.0;
+    TEST_CHECK_EQ(rate_window(&rc, w++, object), MLX90632_MEAS_HZ_8);
+    TEST_CHECK_EQ(rate_window(&rc, w++, object), MLX90632_MEAS_HZ_4);
+    object += 1.0;
+    TEST_CHECK_EQ(rate_window(&rc, w++, object), MLX90632_MEAS_HZ_8);
+
+    //calm signal: the rate stays at max until the next boot
+    TEST_CHECK_EQ(rate_window(&rc, w++, object), MLX90632_MEAS_HZ_8);
+    TEST_CHECK_EQ(rate_window(&rc, w++, object), MLX90632_MEAS_HZ_8);
+
+    mlx90632_rate_get_stats(&rc, &stats);
+    TEST_CHECK_EQ(stats.ups, 2);
+    TEST_CHECK_EQ(stats.downs, 1);
+    TEST_CHECK_EQ(stats.blocked, 2);
+}
+
+static void test_rate_sync(void){
+    MLXRate_s rc;
+    MLXRateStats_s stats;
+    double object = RATE_OBJECT;
+    uint32_t w;
+
+    mlx90632_rate_init(&rc, NULL, MLX90632_MEAS_HZ_2);
+    rate_window(&rc, 0, object);
+    w = MLX90632_RATE_MIN_CHANGE_MS / MLX90632_RATE_WINDOW_MS;
+    object += 10.0;
+    TEST_CHECK_EQ(rate_window(&rc, w, object), MLX90632_MEAS_HZ_8);
+
+    //the write of 8 Hz failed: back to the rate of the sensor, not asked again at once
+    mlx90632_rate_sync(&rc, MLX90632_MEAS_HZ_2, w * MLX90632_RATE_WINDOW_MS);
+    TEST_CHECK_EQ(rc.rate, MLX90632_MEAS_HZ_2);
+    object += 1.0;
+    TEST_CHECK_EQ(rate_window(&rc, w + 1, object), MLX90632_MEAS_HZ_2);
+
+    mlx90632_rate_get_stats(&rc, &stats);
+    TEST_CHECK_EQ(stats.syncs, 1);
+    TEST_CHECK_EQ(stats.blocked, 1);
+}
+
+int main(void){
+    TEST_RUN(test_set_refresh_rate);
+    TEST_RUN(test_set_refresh_rate_restore);
+    TEST_RUN(test_rate_min_change);
+    TEST_RUN(test_rate_budget);
+    TEST_RUN(test_rate_sync);
+    return test_result();
+}
@@ -0,0 +1,89 @@
+/******************************************************************************
+ * Copyright (c) 2025 Marconatale Parise.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * You may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************/
+/**
+ * @file mlx90632_test_ring.c
+ * @brief host tests of the raw sample ring
+ *
+ */
+#include "mlx90632_ring.h"
+#include "mlx90632_test.h"
+
+static MLXRing_s ring;
+
+static void test_ring_order(void){
+    MLXSample_s in = {0}, out;
+    MLXRingStats_s stats;
+    uint32_t i;
+
+    mlx90632_ring_init(&ring);
+    TEST_CHECK(!mlx90632_ring_get(&ring, &out));
+
+    //indexes run past the buffer many times
+    for (i = 0; i < 10 * MLX90632_RING_SIZE; i++){
+        in.timestamp_us = i;
+        in.cycle_pos = (uint8_t)(1 + (i & 1));
+        TEST_CHECK(mlx90632_ring_put(&ring, &in));
+        TEST_CHECK(mlx90632_ring_get(&ring, &out));
+        TEST_CHECK_EQ(out.timestamp_us, i);
+        TEST_CHECK_EQ(out.cycle_pos, in.cycle_pos);
+    }
+
+    mlx90632_ring_get_stats(&ring, &stats);
+    TEST_CHECK_EQ(stats.count, 0);
+    TEST_CHECK_EQ(stats.overruns, 0);
+    TEST_CHECK_EQ(stats.high_water, 1);
+}
+
+static void test_ring_overrun(void){
+    MLXSample_s in = {0}, out;
+    MLXRingStats_s stats;
+    uint32_t i;
+
+    mlx90632_ring_init(&ring);
+    for (i = 0; i < MLX90632_RING_SIZE; i++){
+        in.timestamp_us = i;
+        TEST_CHECK(mlx90632_ring_put(&ring, &in));
+    }
+
+    //a full ring drops the new sample, the queued ones are kept
+    in.timestamp_us = 1000;
+    TEST_CHECK(!mlx90632_ring_put(&ring, &in));
+    TEST_CHECK(!mlx90632_ring_put(&ring, &in));
+
+    mlx90632_ring_get_stats(&ring, &stats);
+    TEST_CHECK_EQ(stats.count, MLX90632_RING_SIZE);
+    TEST_CHECK_EQ(stats.overruns, 2);
+    TEST_CHECK_EQ(stats.high_water, MLX90632_RING_SIZE);
+
+    for (i = 0; i < MLX90632_RING_SIZE; i++){
+        TEST_CHECK(mlx90632_ring_get(&ring, &out));
+        TEST_CHECK_EQ(out.timestamp_us, i);
+    }
+    TEST_CHECK(!mlx90632_ring_get(&ring, &out));
+
+    //high water is a maximum, it does not follow the fill level down
+    TEST_CHECK(mlx90632_ring_put(&ring, &in));
+    mlx90632_ring_get_stats(&ring, &stats);
+    TEST_CHECK_EQ(stats.count, 1);
+    TEST_CHECK_EQ(stats.high_water, MLX90632_RING_SIZE);
+}
+
+int main(void){
+    TEST_RUN(test_ring_order);
+    TEST_RUN(test_ring_overrun);
+    return test_result();
+}
@@ -0,0 +1,117 @@
+/******************************************************************************
+ * Copyright (c) 2025 Marconatale Parise.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * You may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************/
+/**
+ * @file mlx90632_test_rolling.c
+ * @brief host tests of the rolling statistics against a brute force computation
+ *
+ * 300000 samples 16 ms apart (about 80 minutes at 62.5 Hz) cross the wrap of the ms counter.
+ * Each window summary is checked against count, mean, variance, min and max computed over the
+ * stored samples that fall in the buckets of the window.
+ *
+ */
+#include <stdlib.h>
+#include "mlx90632_rolling.h"
+#include "mlx90632_test.h"
+
+#define ROLLING_SAMPLES 300000
+#define ROLLING_STEP_MS 16
+
+static const uint32_t spans[MLX90632_ROLLING_MAX_WINDOWS] = {1000, 60000, 3600000};
+static double object[ROLLING_SAMPLES];
+static uint32_t stamp[ROLLING_SAMPLES];
+static uint32_t noise_state = 1;
+
+static double noise_uniform(void){
+    noise_state = noise_state * 1664525U + 1013904223U;
+    return (noise_state >> 8) / 16777216.0;
+}
+
+static void test_rolling_brute_force(void){
+    static MLXRolling_s rolling;
+    MLXRollingSummary_s summary;
+    MLXTemp_s temp;
+    uint32_t start = 0xFFFFFFFFU - 500000U;
+    uint32_t now = 0, first, len;
+    double sum, sum2, min, max, mean;
+    uint32_t count;
+    int i, w;
+
+    TEST_CHECK_EQ(mlx90632_rolling_init(&rolling, spans, ARRAY_SIZE(spans), start), 0);
+    for (i = 0; i < ROLLING_SAMPLES; i++){
+        now = start + (uint32_t)i * ROLLING_STEP_MS;
+        temp.ambient = 25.0;
+        temp.object = 37.0 + 0.1 * sin(i * 0.001) + 0.02 * (noise_uniform() - 0.5);
+        mlx90632_rolling_add(&rolling, &temp, now);
+        object[i] = temp.object;
+        stamp[i] = now;
+    }
+    //the last sample is past the wrap
+    TEST_CHECK(now < start);
+
+    for (w = 0; w < MLX90632_ROLLING_MAX_WINDOWS; w++){
+        TEST_CHECK_EQ(mlx90632_rolling_get(&rolling, (uint8_t)w, now, NULL, &summary), 0);
+
+        //the current bucket and the MLX90632_ROLLING_BUCKETS - 1 before it
+        len = spans[w];
+        first = rolling.window[w].start_ms - (MLX90632_ROLLING_BUCKETS - 1) * rolling.window[w].bucket_ms;
+        count = 0;
+        sum = 0.0;
+        min = INFINITY;
+        max = -INFINITY;
+        for (i = 0; i < ROLLING_SAMPLES; i++){
+            if (stamp[i] - first >= len)
+                continue;
+            count++;
+            sum += object[i];
+            min = fmin(min, object[i]);
+            max = fmax(max, object[i]);
+        }
+        mean = sum / count;
+        sum2 = 0.0;
+        for (i = 0; i < ROLLING_SAMPLES; i++){
+            if (stamp[i] - first < len)
+                sum2 += (object[i] - mean) * (object[i] - mean);
+        }
+
+        printf("window %u ms: %u samples, mean %.6f variance %.3e\n", spans[w], summary.count, summary.mean, summary.variance);
+        TEST_CHECK_EQ(summary.count, count);
+        TEST_CHECK_NEAR(summary.mean, mean, 1e-9);
+        TEST_CHECK_NEAR(summary.variance, sum2 / (count - 1), 1e-9 * sum2 / (count - 1));
+        //min and max are kept in float
+        TEST_CHECK_NEAR(summary.min, min, 1e-5);
+        TEST_CHECK_NEAR(summary.max, max, 1e-5);
+    }
+
+    //a gap longer than the span empties the window
+    TEST_CHECK_EQ(mlx90632_rolling_get(&rolling, 0, now + 5000, NULL, &summary), 0);
+    TEST_CHECK_EQ(summary.count, 0);
+}
+
+static void test_rolling_errors(void){
+    static MLXRolling_s rolling;
+    const uint32_t short_span = MLX90632_ROLLING_BUCKETS - 1;
+
+    TEST_CHECK_EQ(mlx90632_rolling_init(&rolling, &short_span, 1, 0), -EINVAL);
+    TEST_CHECK_EQ(mlx90632_rolling_init(&rolling, spans, 1, 0), 0);
+    TEST_CHECK_EQ(mlx90632_rolling_get(&rolling, 1, 0, NULL, NULL), -EINVAL);
+}
+
+int main(void){
+    TEST_RUN(test_rolling_brute_force);
+    TEST_RUN(test_rolling_errors);
+    return test_result();
+}
@@ -0,0 +1,134 @@
+/******************************************************************************
+ * Copyright (c) 2025 Marconatale Parise.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * You may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************/
+/**
+ * @file mlx90632_test_stream.c
+ * @brief host tests of the binary sample stream encoder and decoder
+ *
+ */
+#include <string.h>
+#include "mlx90632_stream.h"
+#include "mlx90632_test.h"
+
+static void stream_record(MLXStreamRecord_s *rec, uint16_t seq){
+    memset(rec, 0, sizeof(*rec));
+    rec->timestamp_us = 1000000U + seq * 15625U;
+    rec->seq = seq;
+    rec->sensor_id = 1;
+    rec->cycle_pos = (uint8_t)(1 + (seq & 1));
+    rec->flags = MLX90632_STREAM_FLAG_RAW | MLX90632_STREAM_FLAG_TEMP;
+    rec->raw.ambient_ram_6 = 25658;
+    rec->raw.ambient_ram_9 = 30000;
+    rec->raw.object_ram_4_7 = 1149;
+    rec->raw.object_ram_5_8 = -1149;
+    rec->ambient_centi = mlx90632_stream_centi(25.004);
+    rec->object_centi = mlx90632_stream_centi(-36.996);
+}
+
+static void stream_feed(MLXStreamDecoder_s *dec, const uint8_t *buf, size_t len, uint16_t *seqs, uint32_t *count){
+    MLXStreamRecord_s rec;
+    size_t i;
+
+    for (i = 0; i < len; i++){
+        if (mlx90632_stream_feed(dec, buf[i], &rec))
+            seqs[(*count)++] = rec.seq;
+    }
+}
+
+static void test_stream_roundtrip(void){
+    MLXStreamRecord_s in, out;
+    uint8_t frame[MLX90632_STREAM_FRAME_LEN];
+
+    stream_record(&in, 7);
+    mlx90632_stream_encode(&in, frame);
+    TEST_CHECK_EQ(frame[0], MLX90632_STREAM_SYNC0);
+    TEST_CHECK_EQ(frame[1], MLX90632_STREAM_SYNC1);
+
+    memset(&out, 0, sizeof(out));
+    TEST_CHECK_EQ(mlx90632_stream_decode(frame, &out), 0);
+    TEST_CHECK_EQ(out.timestamp_us, in.timestamp_us);
+    TEST_CHECK_EQ(out.seq, 7);
+    TEST_CHECK_EQ(out.sensor_id, 1);
+    TEST_CHECK_EQ(out.cycle_pos, 2);
+    TEST_CHECK_EQ(out.flags, in.flags);
+    TEST_CHECK_EQ(out.raw.ambient_ram_6, 25658);
+    TEST_CHECK_EQ(out.raw.ambient_ram_9, 30000);
+    TEST_CHECK_EQ(out.raw.object_ram_4_7, 1149);
+    TEST_CHECK_EQ(out.raw.object_ram_5_8, -1149);
+    TEST_CHECK_EQ(out.ambient_centi, 2500);
+    TEST_CHECK_EQ(out.object_centi, -3700);
+
+    frame[10] ^= 0x01;
+    TEST_CHECK_EQ(mlx90632_stream_decode(frame, &out), -EBADMSG);
+    frame[10] ^= 0x01;
+    frame[2] = MLX90632_STREAM_VERSION + 1;
+    TEST_CHECK_EQ(mlx90632_stream_decode(frame, &out), -EBADMSG);
+
+    TEST_CHECK_EQ(mlx90632_stream_centi(1000.0), INT16_MAX);
+    TEST_CHECK_EQ(mlx90632_stream_centi(-1000.0), INT16_MIN);
+}
+
+static void test_stream_resync(void){
+    static const char text[] = "boot\r\n";
+    MLXStreamDecoder_s dec;
+    MLXStreamRecord_s rec;
+    uint8_t frame[MLX90632_STREAM_FRAME_LEN];
+    uint16_t seqs[8];
+    uint32_t count = 0;
+
+    mlx90632_stream_decoder_init(&dec);
+
+    //console text before the first frame
+    stream_feed(&dec, (const uint8_t *)text, strlen(text), seqs, &count);
+
+    stream_record(&rec, 1);
+    mlx90632_stream_encode(&rec, frame);
+    stream_feed(&dec, frame, sizeof(frame), seqs, &count);
+
+    //corrupted frame: dropped whole, counted as crc error and as lost by sequence
+    stream_record(&rec, 2);
+    mlx90632_stream_encode(&rec, frame);
+    frame[20] ^= 0x40;
+    stream_feed(&dec, frame, sizeof(frame), seqs, &count);
+
+    stream_record(&rec, 3);
+    mlx90632_stream_encode(&rec, frame);
+    stream_feed(&dec, frame, sizeof(frame), seqs, &count);
+
+    //truncated frame: the sync of the next frame is found inside the bad one
+    stream_record(&rec, 4);
+    mlx90632_stream_encode(&rec, frame);
+    stream_feed(&dec, frame, 10, seqs, &count);
+
+    stream_record(&rec, 5);
+    mlx90632_stream_encode(&rec, frame);
+    stream_feed(&dec, frame, sizeof(frame), seqs, &count);
+
+    TEST_CHECK_EQ(count, 3);
+    TEST_CHECK_EQ(seqs[0], 1);
+    TEST_CHECK_EQ(seqs[1], 3);
+    TEST_CHECK_EQ(seqs[2], 5);
+    TEST_CHECK_EQ(dec.frames, 3);
+    TEST_CHECK_EQ(dec.crc_errors, 2);
+    TEST_CHECK_EQ(dec.lost, 2);
+    TEST_CHECK_EQ(dec.skipped, strlen(text) + MLX90632_STREAM_FRAME_LEN + 10);
+}
+
+int main(void){
+    TEST_RUN(test_stream_roundtrip);
+    TEST_RUN(test_stream_resync);
+    return test_result();
+}
@@ -0,0 +1,89 @@
+/******************************************************************************
+ *
+ * Copyright (c) 2025 Marconatale Parise. All rights reserved.
+ *
+ * This file is part of proprietary software. Unauthorized copying, distribution,
+ * or modification of this file, via any medium, is strictly prohibited without
+ * prior written permission from the copyright holder.
+ *
+ *****************************************************************************/
+/**
+ * @file acquisition.h
+ * @brief this file contain the functions prototype to control melexis acquisition and processing threads
+ *
+ * The acquisition thread only performs i2c and moves raw samples (with timestamp and cycle
+ * position) into a lock-free SPSC ring. The processing thread converts samples to temperatures
+ * and publishes them, so slow output does not delay sampling.
+ *
+ * The following functions will be implemented:
+ * - acquisition_start() to start sampling
+ * - acquisition_stop() to stop sampling
+ * - acquisition_get_ring_stats() to get ring fill level, overruns and high-water mark
+ * 
+ * @author Marconatale Parise
+ * @date 09 June 2025
+ *
+ */
+
+#ifndef __ACQUISITION_H__
+#define __ACQUISITION_H__
+
+#include "common.h"
+#include "mlx90632.h"
+#include "mlx90632_ring.h"
+#include "mlx90632_kernel.h"
+#include "mlx90632_rate.h"
+#include "mlx90632_filter.h"
+#include "mlx90632_rolling.h"
+#include "uart_stream.h"
+#if MLX_MULTI
+#include "mlx90632_sched.h"
+#endif
+
+#define ACQ_STACK_SIZE      (MLX_MULTI ? 2048 : 1024) //with MLX_MULTI samples are printed from the acquisition thread
+#define ACQ_PRIORITY        5
+#define PROC_STACK_SIZE     2048
+#define PROC_PRIORITY       7
+#define ACQ_ERROR_BACKOFF   100 //ms to wait before retrying after an acquisition error
+#define ACQ_SCHED_STATS_PERIOD 10000 //ms between scheduler statistics when MLX_MULTI is set
+#define ACQ_FILTER_GAP      10000 //ms without samples after which the filter restarts from the next sample
+#define ACQ_SAMPLE_PERIOD   1000  //ms between measurement starts from an absolute k_timer, 0: back to back at the refresh rate
+#define ACQ_ROLLING_SPANS   {1000, 60000, 3600000} //ms spans of the MLX_ROLLING windows, at most MLX90632_ROLLING_MAX_WINDOWS
+
+/**
+ * @brief Start acquisition
+ *
+ * Wake up the acquisition thread. In continuous mode (MLX_CONTINUOUS) the sensor is set in
+ * continuous mode before the first sample, with MLX_BURST each wake up of the sensor measures
+ * the whole table and queues both cycle positions. With MLX_MULTI every okay melexis node is sampled
+ * through the scheduler instead, interleaving their conversions.
+ * With ACQ_SAMPLE_PERIOD each measurement in step mode starts on a tick of a periodic k_timer, so the
+ * sample period does not drift with the time spent measuring; ticks missed by a slow measurement
+ * are dropped, not queued. The default of 1 s is longer than a step measurement at the factory
+ * refresh rate (2 Hz), so the sensor sleeps between samples; a period shorter than the
+ * measurement gives back to back samples. With MLX_ADAPTIVE_RATE the controller sets the pace and
+ * samples are back to back.
+ *
+ * @return void
+ */
+void acquisition_start(void);
+
+/**
+ * @brief Stop acquisition
+ *
+ * The acquisition thread stops after the sample in progress and waits for acquisition_start().
+ *
+ * @return void
+ */
+void acquisition_stop(void);
+
+/**
+ * @brief Get ring statistics
+ *
+ * @param stats pointer to the struct to fill with fill level, overruns and high-water mark
+ *
+ * @return void
+ */
+void acquisition_get_ring_stats(MLXRingStats_s *stats);
+
+#endif /* __ACQUISITION_H__ */
@@ -26,12 +26,35 @@
 #define __COMMON_H__
 
 
-#define DEBUG 1
-#define DEBUG_MLX 0
+#define DEBUG 1            //host build: LOG() printed, on Zephyr levels are set by CONFIG_<module>_LOG_LEVEL (Kconfig)
+#define DEBUG_MLX 0        //host build: LOG_MLX() printed, on Zephyr LOG_MLX() is a debug level message
+#define MLX_KERNEL 0       //0: double reference, 1: float32, 2: Q fixed-point (see mlx90632_kernel.h)
+#define MLX_CONTINUOUS 0   //1: acquisition uses continuous mode, 0: sleeping step mode with SOC per sample
+#define MLX_BURST 0        //1: with MLX_CONTINUOUS 0, one SOB per table and both cycle positions per wake up (see mlx90632_read_burst())
+#define MLX_SOLVER 0       //0: fixed three iterations, 1: warm-started solver stopping on MLX_SOLVER_TOLERANCE
+#define MLX_BUS_STATS 1    //1: per register class i2c counters and latency histograms (see mlx90632_hal.h)
+#define MLX_BENCH 0        //1: time every stage of the measurement path once at boot (see mlx90632_bench.h)
+#define MLX_STREAM 0       //1: samples sent as binary frames on the mlx-stream uart instead of text (see mlx90632_stream.h)
+#define MLX_MULTI 0        //1: acquisition interleaves every melexis sensor in devicetree (see mlx90632_sched.h)
+#define MLX_EXTENDED 0     //1: extended range parts measure the extended table, continuous or burst as MLX_CONTINUOUS, 0: medical range (see mlx90632_extended_meas.h)
+#define MLX_ADAPTIVE_RATE 0 //1: refresh rate follows the object temperature slope, written in EEPROM (see mlx90632_rate.h)
+#define MLX_FILTER 0       //0: none, 1: EMA, 2: median, 3: scalar Kalman on published temperatures (see mlx90632_filter.h)
+#define MLX_ROLLING 0      //1: min, max, mean and variance over 1 s, 1 min, 1 h logged once per window instead of every sample (see mlx90632_rolling.h)
 
-#if DEBUG
+/* On Zephyr messages go to deferred logging: the caller only stores the arguments, the log
+ * thread formats and prints them. Every file using LOG() registers or declares its log module,
+ * messages below the module level (CONFIG_APP/PERIPHERAL/MLX90632/MLX90632_BUS_LOG_LEVEL)
+ * are compiled out. */
+#ifdef __ZEPHYR__
+#include <zephyr/logging/log.h>
+#define LOG(x,...) LOG_INF(x, ##__VA_ARGS__)
+#define LOG_MLX(x,...) LOG_DBG(x, ##__VA_ARGS__)
+#elif DEBUG
 #define LOG(x,...) if(DEBUG){printf("[%u ms] " x "\n", k_uptime_get_32(), ##__VA_ARGS__);}
 #define LOG_MLX(x,...) if(DEBUG_MLX){printf("[%u ms] " x "\n", k_uptime_get_32(), ##__VA_ARGS__);}
+#else
+#define LOG(x,...)
+#define LOG_MLX(x,...)
 #endif
 
 
@@ -27,6 +27,8 @@
  * - gpio_configure() to configure the gpio pin for a specific channel
  * - reset_gpio_interrupt() to reset the gpio interrupt status for a specific channel
  * - get_gpio_interrupt_status() to get the gpio interrupt status for a specific channel
+ * - gpio_set_event_handler() to be notified of gpio interrupts from interrupt context
+ * - get_gpio_level() to read the logical level of the pin of a specific channel
  * 
  * @author Marconatale Parise
  * @date 09 June 2025
@@ -66,6 +68,8 @@ typedef struct
 
 }Gpio_t;
 
+typedef void (*gpio_event_handler_t)(uint32_t channels);
+
 /**
  * @brief Enable or disable gpio interrupt
  *
@@ -167,4 +171,29 @@ void reset_gpio_interrupt(Gpio_t* gt, uint8_t channel);
  */
 bool get_gpio_interrupt_status(Gpio_t* gt, uint8_t channel);
 
+/**
+ * @brief Set gpio event handler
+ *
+ * The handler is called from the gpio interrupt with BIT(channel) of every channel that
+ * triggered, after the interrupt status is set. It must be interrupt safe.
+ *
+ * @param handler function pointer to the handler, NULL to remove it
+ *
+ * @return void
+ */
+void gpio_set_event_handler(gpio_event_handler_t handler);
+
+/**
+ * @brief Get gpio logical level
+ *
+ * Read the pin of a specific channel, active low flags from device tree applied. Safe from
+ * interrupts and timer expiry functions.
+ *
+ * @param gt gpio struct pointer to the gpio array
+ * @param channel 8-bit value that indicate channel of gpio struct array
+ *
+ * @return bool true if the pin is active, false if inactive, disabled or on read error
+ */
+bool get_gpio_level(Gpio_t* gt, uint8_t channel);
+
 #endif
\ No newline at end of file
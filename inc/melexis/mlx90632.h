@@ -39,7 +39,7 @@
 #define _MLX90632_LIB_
 
 /* Including CRC calculation functions */
-#include <zephyr/kernel.h>
+#include "mlx90632_port.h"
 #include "common.h"
 #include "mlx90632_extended_meas.h"
 #include "mlx90632_hal.h"
@@ -91,6 +91,9 @@
 #define MLX90632_EE_CONTROL MLX90632_EE_CTRL /**< More human readable for Control register */
 
 #define MLX90632_EE_I2C_ADDRESS 0x24d5 /**< I2C address register initial value */
+#define MLX90632_EE_ID0 0x2405 /**< Chip ID word 0 */
+#define MLX90632_EE_ID1 0x2406 /**< Chip ID word 1 */
+#define MLX90632_EE_ID2 0x2407 /**< Chip ID word 2 */
 #define MLX90632_EE_VERSION 0x240b /**< EEPROM version reg - assumed 0x101 */
 
 #define MLX90632_EE_P_R     0x240c /**< Calibration constant ambient reference register 32bit */
@@ -115,6 +118,14 @@
 #define MLX90632_EE_Ha      0x2481 /**< Ha customer calibration value register 16bit */
 #define MLX90632_EE_Hb      0x2482 /**< Hb customer calibration value register 16bit */
 
+/* EEPROM calibration windows - read with one burst each */
+#define MLX90632_EE_CALIB_START     MLX90632_EE_P_R /**< First word of the calibration constants window */
+#define MLX90632_EE_CALIB_END       MLX90632_EE_Ka /**< Last word of the calibration constants window */
+#define MLX90632_EE_CALIB_LEN       (MLX90632_EE_CALIB_END - MLX90632_EE_CALIB_START + 1) /**< Number of words in the calibration window */
+#define MLX90632_EE_CUSTOMER_START  MLX90632_EE_Ha /**< First word of the customer calibration window */
+#define MLX90632_EE_CUSTOMER_END    MLX90632_EE_Hb /**< Last word of the customer calibration window */
+#define MLX90632_EE_CUSTOMER_LEN    (MLX90632_EE_CUSTOMER_END - MLX90632_EE_CUSTOMER_START + 1) /**< Number of words in the customer window */
+
 #define MLX90632_EE_MEDICAL_MEAS1      0x24E1 /**< Medical measurement 1 16bit */
 #define MLX90632_EE_MEDICAL_MEAS2      0x24E2 /**< Medical measurement 2 16bit */
 #define MLX90632_EE_EXTENDED_MEAS1     0x24F1 /**< Extended measurement 1 16bit */
@@ -146,6 +157,7 @@ typedef enum mlx90632_meas_e {
 
 /* Control register address - volatile */
 #define MLX90632_REG_CTRL   0x3001 /**< Control Register address */
+#define MLX90632_REG_CMD    0x3005 /**< Command register: EEPROM unlock key and reset */
 #define   MLX90632_CFG_SOC_SHIFT 3 /**< Start measurement in step mode */
 #define   MLX90632_CFG_SOC_MASK BIT(MLX90632_CFG_SOC_SHIFT)
 #define   MLX90632_CFG_PWR_MASK GENMASK(2, 1) /**< PowerMode Mask */
@@ -185,8 +197,19 @@ typedef enum mlx90632_meas_e {
 #define MLX90632_RAM_2(meas_num)    (MLX90632_ADDR_RAM + 3 * meas_num + 1)
 #define MLX90632_RAM_3(meas_num)    (MLX90632_ADDR_RAM + 3 * meas_num + 2)
 
+/* RAM window holding both cycle positions of the medical measurement table (RAM_4..RAM_9) */
+#define MLX90632_RAM_BLOCK_START    MLX90632_RAM_1(1) /**< First address of the medical RAM window */
+#define MLX90632_RAM_BLOCK_END      MLX90632_RAM_3(2) /**< Last address of the medical RAM window */
+#define MLX90632_RAM_BLOCK_LEN      (MLX90632_RAM_BLOCK_END - MLX90632_RAM_BLOCK_START + 1) /**< Number of words in the medical RAM window */
+#define MLX90632_RAM_BLOCK_IDX(addr) ((addr) - MLX90632_RAM_BLOCK_START) /**< Index of a RAM address inside the window buffer */
+#define MLX90632_RAM_EXT_BLOCK_START MLX90632_RAM_1(17) /**< First address of the extended RAM window (meas 17..19) */
+#define MLX90632_RAM_EXT_BLOCK_END  MLX90632_RAM_3(19) /**< Last address of the extended RAM window */
+#define MLX90632_RAM_EXT_BLOCK_LEN  (MLX90632_RAM_EXT_BLOCK_END - MLX90632_RAM_EXT_BLOCK_START + 1) /**< Number of words in the extended RAM window */
+#define MLX90632_RAM_EXT_BLOCK_IDX(addr) ((addr) - MLX90632_RAM_EXT_BLOCK_START) /**< Index of a RAM address inside the extended window buffer */
+
 /* Timings (ms) */
 #define MLX90632_TIMING_EEPROM 100 /**< Time between EEPROM writes */
+#define MLX90632_EEPROM_RESTORE_TRIES 3 /**< Writes of the previous value after a failed EEPROM write */
 
 /* Magic constants */
 #define MLX90632_DSPv5 0x05 /* EEPROM DSP version */
@@ -211,6 +234,9 @@ typedef enum mlx90632_meas_e {
 
 #define MLX90632_MEAS_MAX_TIME 2000 /**< Maximum measurement time in ms for the lowest possible refresh rate */
 #define MLX90632_MAX_NUMBER_MESUREMENT_READ_TRIES 100 /**< Maximum number of read tries before quiting with timeout error */
+#define MLX90632_MEDICAL_TABLE_LEN 2 /**< Measurements in the medical table (cycle positions 1 and 2) */
+#define MLX90632_EXTENDED_TABLE_LEN 3 /**< Measurements in the extended table (cycle positions 17, 18 and 19) */
+#define MLX90632_EXTENDED_LAST_POS 19 /**< Cycle position of the last extended measurement */
 
 /* Gets a new register value based on the old register value - only writing the value based on the desired bits
  * Masks the old register and shifts the new value in
@@ -235,6 +261,11 @@ typedef struct{
     float Hb;
 }MLXCalib_s;
 
+typedef struct{
+    uint16_t calib[MLX90632_EE_CALIB_LEN];
+    uint16_t customer[MLX90632_EE_CUSTOMER_LEN];
+}MLXEeprom_s;
+
 typedef struct{
     int16_t ambient_ram_6; 
     int16_t ambient_ram_9;
@@ -247,16 +278,39 @@ typedef struct{
     double object; 
 }MLXTemp_s;
 
+typedef struct{
+    MLXTempRaw_s raw[MLX90632_MEDICAL_TABLE_LEN];   /**< one record per completed table position, oldest first */
+    uint8_t cycle_pos[MLX90632_MEDICAL_TABLE_LEN];  /**< cycle position of each record */
+    uint8_t count;                                  /**< records filled by mlx90632_read_burst() */
+}MLXBurst_s;
+
 typedef struct{
     uint8_t refresh; 
     bool comm_sts;
-    uint16_t wait_time_meas;
+    uint32_t conv_time_us;
     uint8_t count_check_meas;
+    uint8_t mode;               /**< MLX90632_PWR_STATUS_SLEEP_STEP or MLX90632_PWR_STATUS_CONTINUOUS */
+    int8_t last_cycle_pos;      /**< cycle position of last sample read in continuous mode */
+    uint64_t last_ready_us;     /**< time of last sample read in continuous mode */
+    uint8_t meas_type;          /**< MLX90632_MTYP_* set by mlx90632_set_meas_type() */
 }MLXStatus_s;
 
-#define MLX90632_MAX_NUM_CHECK_MEAS 50 /**< Maximum number of measure checking. After that, waiting time will be updated */
-#define MLX90632_STEP_WAIT_TIME 250  //Increase wait timing before next measurement of 250us 
-#define MLX90632_MAX_WAIT_TIME 5000  //Limit wait timing before next measurement of 5000us 
+typedef struct{
+    uint16_t last;      /**< status reads used by last sample */
+    uint16_t max;       /**< maximum status reads used by a sample */
+    uint32_t total;     /**< status reads used since last reset */
+    uint32_t samples;   /**< samples measured since last reset */
+}MLXPollStats_s;
+
+extern MLXCalib_s MLX_K;
+extern MLXTempRaw_s MLX_T_RAW;
+extern MLXTemp_s MLX_T;
+extern MLXStatus_s MLX_STS;
+
+#define MLX90632_MAX_NUM_CHECK_MEAS 50 /**< Number of consecutive measurement timeouts before sensor reset */
+#define MLX90632_WAKEUP_MARGIN_DIV 16 /**< Wake up conv_time/16 before expected data ready */
+#define MLX90632_POLL_INTERVAL_DIV 64 /**< Poll status every conv_time/64 after wake up */
+#define MLX90632_MIN_POLL_INTERVAL 100 /**< Minimum status poll interval in us */
 /* ==== End custom code ==== */
 
 /**
@@ -317,7 +371,8 @@ bool i2c_melexis_e2busy();
  *
  * @param mode 8-bit value that could be MLX90632_PWR_STATUS_SLEEP_STEP, MLX90632_PWR_STATUS_STEP or MLX90632_PWR_STATUS_CONTINUOUS
  *
- * @return int32_t value that is 0 if successfully set mode, <0 if something went wrong
+ * @return int32_t value that is 0 if successfully set mode, -ETIMEDOUT if the mode bits did not change after
+ *         MLX90632_MAX_NUMBER_MESUREMENT_READ_TRIES writes, <0 if something went wrong
  */
 int32_t i2c_melexis_setmode(uint8_t mode);
 
@@ -325,14 +380,41 @@ int32_t i2c_melexis_setmode(uint8_t mode);
  * @brief Read calibration data from melexis eeprom
  * @author Marconatale Parise
  * 
- * Read calibration data from melexis eeprom and store it in the global MLX_K struct.
+ * Wait up to MLX90632_TIMING_EEPROM ms for EE_BUSY to clear, read calibration data from melexis
+ * eeprom with mlx90632_readEeprom(), decode it with mlx90632_decodeCalib() and store it in the
+ * global MLX_K struct.
  *
  * @param no data
  *
- * @return int32_t value that is 0 if successfully set mode, <0 if something went wrong
+ * @return int32_t value that is 0 if successfully read, -ETIMEDOUT if the eeprom stayed busy, <0 if something went wrong
  */
 int32_t mlx90632_readCalib();
 
+/**
+ * @brief Read calibration eeprom image
+ *
+ * Read the calibration window (MLX90632_EE_P_R..MLX90632_EE_Ka) and the customer window
+ * (MLX90632_EE_Ha..MLX90632_EE_Hb) with one burst read each.
+ *
+ * @param ee pointer to the eeprom image to fill
+ *
+ * @return int32_t value that is 0 if successfully read, <0 if something went wrong
+ */
+int32_t mlx90632_readEeprom(MLXEeprom_s *ee);
+
+/**
+ * @brief Decode calibration constants from eeprom image
+ *
+ * Each coefficient is decoded as described in the calibration table (address, 16/32-bit width
+ * and fixed-point shift) and stored in the calibration struct.
+ *
+ * @param ee pointer to the eeprom image read with mlx90632_readEeprom()
+ * @param calib pointer to the calibration struct to fill
+ *
+ * @return void
+ */
+void mlx90632_decodeCalib(const MLXEeprom_s *ee, MLXCalib_s *calib);
+
 /**
  * @brief Set soc bit 
  * @author Marconatale Parise
@@ -354,6 +436,44 @@ int32_t i2c_melexis_set_soc();
  */
 mlx90632_meas_t mlx90632_get_refresh_rate(void);
 
+/** Write one EEPROM word
+ *
+ * Unlock with MLX90632_EEPROM_WRITE_KEY, erase the word, unlock again and program the value,
+ * waiting up to MLX90632_TIMING_EEPROM ms for EE_BUSY after each write. Every call costs two
+ * write cycles of the word, so callers only write changed values.
+ *
+ * A failed erase or program would leave the word at 0x0000: the value read before the erase is
+ * written back, up to MLX90632_EEPROM_RESTORE_TRIES times.
+ *
+ * @param addr EEPROM address
+ * @param value new value
+ *
+ * @retval 0 Successfully written
+ * @retval -EFAULT The write failed and the previous value could not be restored
+ * @retval <0 Something went wrong, the previous value is in place. -ETIMEDOUT if the EEPROM stayed busy
+ *
+ * @note This function is using usleep so it is blocking!
+ */
+int32_t mlx90632_eeprom_write(uint16_t addr, uint16_t value);
+
+/** Set the refresh rate of the current measurement table
+ *
+ * Write the refresh rate field of every measurement of the table (EE_MEDICAL_MEAS1/2 or
+ * EE_EXTENDED_MEAS1/2/3), skipping words that already hold the rate, then reset the sensor so
+ * the new rate is used and update MLX_STS.refresh and MLX_STS.conv_time_us. When a write fails
+ * the words already written get their old value back, so the table keeps one rate.
+ *
+ * @param rate new refresh rate
+ *
+ * @retval 1 The EEPROM was written and the sensor reset
+ * @retval 0 The rate was already set, nothing written, MLX_STS updated
+ * @retval -EFAULT A word could not be restored, the table in EEPROM is not valid any more
+ * @retval <0 Something went wrong, the old rate is still in EEPROM. Check errno.h for more details
+ *
+ * @note This function is using usleep so it is blocking!
+ */
+int32_t mlx90632_set_refresh_rate(mlx90632_meas_t rate);
+
 /** Trigger system reset for mlx90632
  *
  * Perform full reset of mlx90632 using reset command.
@@ -404,7 +524,8 @@ void mlx90632_check_i2c_comm(void);
 /** Start measurement procedure where
   * - set mode desiderated
  * - prepare sensor to next reading
- * - polling procedure with timeout where reading bit is checked
+ * - sleep until just before data ready based on MLX_STS.conv_time_us
+ * - short bounded polling procedure where reading bit is checked
  * 
  * @param no_data
  * @param[out] no_data
@@ -413,6 +534,73 @@ void mlx90632_check_i2c_comm(void);
  */
 int mlx90632_start_measurement();
 
+/**
+ * @brief Start a burst measurement of the whole table in sleeping step mode
+ *
+ * Set SOB in control register, sleep for the measurements of the table of the current
+ * measurement type (MLX90632_MEDICAL_TABLE_LEN or MLX90632_EXTENDED_TABLE_LEN conversion
+ * times), then poll until the device is no longer busy. The sensor sleeps again at the end.
+ *
+ * @param no_data
+ *
+ * @return int32_t value that is 0 if the table is measured, -ETIMEDOUT or <0 on bus error
+ */
+int32_t mlx90632_start_measurement_burst(void);
+
+/**
+ * @brief Start continuous acquisition
+ *
+ * Set the sensor in MLX90632_PWR_STATUS_CONTINUOUS mode. The sensor then measures both cycle
+ * positions (RAM_4/5 and RAM_7/8) back to back without further control register writes.
+ * Data ready is cleared, so the first sample waited is a new one.
+ *
+ * @param no_data
+ *
+ * @return int32_t value that is 0 if successfully set mode, <0 if something went wrong
+ */
+int32_t mlx90632_start_continuous(void);
+
+/**
+ * @brief Stop continuous acquisition
+ *
+ * Set the sensor back in MLX90632_PWR_STATUS_SLEEP_STEP mode used by mlx90632_read().
+ *
+ * @param no_data
+ *
+ * @return int32_t value that is 0 if successfully set mode, <0 if something went wrong
+ */
+int32_t mlx90632_stop_continuous(void);
+
+/**
+ * @brief Wait next half-cycle in continuous mode and read raw values
+ *
+ * Sleep until just before the next cycle position is expected to complete, then poll status
+ * until MLX90632_STAT_DATA_RDY is set. Raw values of the position in MLX90632_STAT_CYCLE_POS
+ * are stored in MLX_T_RAW with one burst read, then data ready is cleared. A cycle position
+ * seen twice in a row (one sample missed) is still a new sample.
+ * In MLX90632_MTYP_EXTENDED the sample is the whole extended table: data ready is waited at
+ * position MLX90632_EXTENDED_LAST_POS and MLX_T_RAW is read with mlx90632_readTempRawExtendedRam().
+ * If i2c communication was lost the sensor is initialized and continuous mode restarted.
+ *
+ * @param no_data
+ *
+ * @retval int cycle position (1 or 2, MLX90632_EXTENDED_LAST_POS in extended range) of the new
+ * data, -EINVAL if the extended object value overflows, <0 if something went wrong
+ */
+int mlx90632_wait_continuous(void);
+
+/**
+ * @brief Read next sample in continuous mode
+ *
+ * Raw values are read with mlx90632_wait_continuous() then processed in MLX_T. A new object
+ * temperature is available every half measurement cycle.
+ *
+ * @param no_data
+ *
+ * @retval int cycle position (1 or 2) of the new data, <0 if something went wrong
+ */
+int mlx90632_read_continuous(void);
+
 /**
  * @brief Read ambient values raw values 
  * @author Marconatale Parise
@@ -426,6 +614,99 @@ int mlx90632_start_measurement();
  */
 int32_t mlx90632_ambTempRaw();
 
+/**
+ * @brief Read all raw values of a measurement with one burst read
+ *
+ * RAM_4..RAM_9 are fetched in a single i2c transaction and decoded into the global MLX_T_RAW:
+ * ambient channels RAM_6/RAM_9 and object channels RAM_4/RAM_5 or RAM_7/RAM_8 depending on cycle_pos.
+ *
+ * @param cycle_pos that is avalaible from status register bits.
+ *
+ * @return int32_t value that is 0 if successfully read, <0 if something went wrong
+ */
+int32_t mlx90632_getTempRaw(int cycle_pos);
+
+/**
+ * @brief Read all raw values of a measurement with one burst read into a record
+ *
+ * Same as mlx90632_getTempRaw() but raw values are stored in the given record instead of
+ * the global MLX_T_RAW.
+ *
+ * @param cycle_pos that is avalaible from status register bits.
+ * @param raw pointer to the record to fill
+ *
+ * @return int32_t value that is 0 if successfully read, <0 if something went wrong
+ */
+int32_t mlx90632_readTempRaw(int cycle_pos, MLXTempRaw_s *raw);
+
+/**
+ * @brief Decode the medical RAM window into a raw record
+ *
+ * @param cycle_pos that is avalaible from status register bits, 1 or 2.
+ * @param ram MLX90632_RAM_BLOCK_LEN words read from MLX90632_RAM_BLOCK_START
+ * @param raw pointer to the record to fill
+ *
+ * @return void
+ */
+void mlx90632_decodeTempRaw(int cycle_pos, const uint16_t *ram, MLXTempRaw_s *raw);
+
+/**
+ * @brief Decode the extended RAM window into a raw record
+ *
+ * The extended channels are mapped on the medical record, so that every kernel, the ring and
+ * the stream handle both ranges: ambient_ram_6 = new ambient (RAM_3 of meas 17),
+ * ambient_ram_9 = old ambient (RAM_3 of meas 18), object_ram_4_7 = object_ram_5_8 = object
+ * combined from meas 17, 18 and 19. The kernels then assume the reflected temperature equal to
+ * the sensor ambient, use mlx90632_calc_temp_object_extended() for another reflected temperature.
+ *
+ * @param ram MLX90632_RAM_EXT_BLOCK_LEN words read from MLX90632_RAM_EXT_BLOCK_START
+ * @param raw pointer to the record to fill
+ *
+ * @return int32_t 0 on success, -EINVAL if the combined object value overflows int16
+ */
+int32_t mlx90632_decodeTempRawExtended(const uint16_t *ram, MLXTempRaw_s *raw);
+
+/**
+ * @brief Measure the extended table in sleeping step burst mode and read it with one burst read
+ *
+ * mlx90632_start_measurement_burst() followed by one read of the extended RAM window, decoded
+ * with mlx90632_decodeTempRawExtended(). The sensor must be in MLX90632_MTYP_EXTENDED_BURST.
+ *
+ * @param raw pointer to the record to fill
+ *
+ * @return int32_t value that is 0 if successfully read, <0 if something went wrong
+ */
+int32_t mlx90632_readTempRawExtended(MLXTempRaw_s *raw);
+
+/**
+ * @brief Read the extended table already measured, with one burst read
+ *
+ * One read of the extended RAM window decoded with mlx90632_decodeTempRawExtended(), no
+ * measurement is started. Used in MLX90632_MTYP_EXTENDED continuous mode once position
+ * MLX90632_EXTENDED_LAST_POS is ready, and by mlx90632_readTempRawExtended().
+ *
+ * @param raw pointer to the record to fill
+ *
+ * @return int32_t value that is 0 if successfully read, <0 if something went wrong
+ */
+int32_t mlx90632_readTempRawExtendedRam(MLXTempRaw_s *raw);
+
+/**
+ * @brief Measure the whole table with one SOB and read every position with one burst read
+ *
+ * In sleeping step mode the sensor wakes up on SOB, measures the table of the current
+ * measurement type and sleeps again: mlx90632_start_measurement_burst() followed by one read of
+ * the RAM window. A medical table gives two records (cycle positions 1 and 2, same ambient,
+ * object of each position), an extended table one record (mlx90632_decodeTempRawExtended()).
+ * Against one SOC per sample the control register is not read back and the status register is
+ * not cleared, so a pair of samples costs 5 bus transactions instead of 14.
+ *
+ * @param burst pointer to the batch to fill
+ *
+ * @return int number of records in the batch, <0 if something went wrong
+ */
+int mlx90632_read_burst(MLXBurst_s *burst);
+
 /**
  * @brief Calculate ambient temperature
  * @author Marconatale Parise
@@ -442,6 +723,23 @@ int32_t mlx90632_ambTempRaw();
  */
 double mlx90632_calc_temp_ambient(double Gb, double PO, double PR, double PG,  double PT);
 
+/**
+ * @brief Calculate ambient temperature from a raw record
+ *
+ * Same as mlx90632_calc_temp_ambient() but raw values are taken from the given record
+ * instead of the global MLX_T_RAW.
+ *
+ * @param raw pointer to the raw record
+ * @param Gb double Calibration Data
+ * @param PO double Calibration Data
+ * @param PR double Calibration Data
+ * @param PG double Calibration Data
+ * @param PT double Calibration Data
+ *
+ * @return double temperature value in degree Celsius
+ */
+double mlx90632_calc_temp_ambient_raw(const MLXTempRaw_s *raw, double Gb, double PO, double PR, double PG,  double PT);
+
 /**
  * @brief Extrapolate ambient temperature
  * @author Marconatale Parise
@@ -491,6 +789,27 @@ double mlx90632_calc_temp_object(double Ka, double Gb, double Ea, double Eb, dou
 
 
 
+/**
+ * @brief Calculation of object temperature from a raw record
+ *
+ * Same as mlx90632_calc_temp_object() but raw values are taken from the given record
+ * instead of the global MLX_T_RAW.
+ *
+ * @param raw pointer to the raw record
+ * @param Ka double register value
+ * @param Gb double register value
+ * @param Ea double register value
+ * @param Eb double register value
+ * @param Fa double register value
+ * @param Ha double register value
+ * @param Ga double register value
+ * @param Fb double register value
+ * @param Hb double register value
+ *
+ * @return double value Calculated object temperature
+ */
+double mlx90632_calc_temp_object_raw(const MLXTempRaw_s *raw, double Ka, double Gb, double Ea, double Eb, double Fa, double Ha, double Ga, double Fb, double Hb);
+
 /** Iterative calculation of object temperature
  *
  * DSPv5 requires 3 iterations to reduce noise for object temperature. Since
@@ -530,8 +849,8 @@ int32_t mlx90632_readObjTemp(int cycle_pos);
  * @brief Process and complete data reading for amb temperature and object temperature.
  * @author Marconatale Parise
  * 
- * Amb temperature is read and processed based on function i2c_melexis_gatherSensorTemp()
- * Object temperature is read and processed based on cycle position function mlx90632_readObjTemp()
+ * Raw ambient and object values are read with a single burst through mlx90632_getTempRaw()
+ * then processed with mlx90632_calc_temp_ambient() and mlx90632_calc_temp_object()
  * 
  * @param no_data
  * 
@@ -570,14 +889,46 @@ uint16_t mlx90632_getTempObj();
  * @brief Check status of measurement
  * @author Marconatale Parise
  *   
- * Update waiting time if number of failure measurement overcome MLX90632_MAX_NUM_CHECK_MEAS value
- * MLX_STS.wait_time_meas is wait time that will be updated of 500us
+ * Count consecutive measurement timeouts and perform mlx90632_addressed_reset() when they
+ * overcome MLX90632_MAX_NUM_CHECK_MEAS value.
  * 
  * @param meas_ret integer that consider the return value of mlx90632_start_measurement() 
  * 
  * @return no data
  */
-void mlx90632_searchWaitTime(int meas_ret);
+void mlx90632_checkTimeout(int meas_ret);
+
+/**
+ * @brief Calculate conversion time from refresh rate
+ *
+ * Conversion time of one measurement in sleeping step mode is MLX90632_MEAS_MAX_TIME at 0.5Hz
+ * and halves at each refresh rate step.
+ *
+ * @param refresh refresh rate read with mlx90632_get_refresh_rate()
+ *
+ * @return uint32_t conversion time in us (MLX90632_MEAS_MAX_TIME if refresh is not valid)
+ */
+uint32_t mlx90632_calc_conv_time(mlx90632_meas_t refresh);
+
+/**
+ * @brief Get status polling statistics
+ *
+ * Number of status register reads used by mlx90632_start_measurement() to detect data ready.
+ *
+ * @param stats pointer to the struct to fill
+ *
+ * @return void
+ */
+void mlx90632_get_poll_stats(MLXPollStats_s *stats);
+
+/**
+ * @brief Reset status polling statistics
+ *
+ * @param no_data
+ *
+ * @return void
+ */
+void mlx90632_reset_poll_stats(void);
 
 /** Permit to set the emissivity
  * 
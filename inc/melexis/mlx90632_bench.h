@@ -0,0 +1,110 @@
+/******************************************************************************
+ * Copyright (c) 2025 Marconatale Parise.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * You may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************/
+/**
+ * @file mlx90632_bench.h
+ * @brief this file contain the microbenchmark of the stages of mlx90632_read()
+ *
+ * Each stage is run in its own loop and every run is timed, then min, mean, p99 and max are
+ * computed from the sorted samples:
+ * - i2c: burst read of the medical RAM window (mlx90632_i2c_read_block())
+ * - poll: one iteration of the data ready polling (status read and cycle position decode)
+ * - decode: RAM window to MLXTempRaw_s (mlx90632_decodeTempRaw())
+ * - ambient: ambient temperature with the kernel selected by MLX_KERNEL
+ * - object: object temperature with the kernel selected by MLX_KERNEL and solver selected by
+ *   MLX_SOLVER (the warm solver also computes the ambient, as in the acquisition path)
+ * - ema, median, kalman: one ambient and object pair through the filters of mlx90632_filter.h
+ *   with their default parameters
+ * - format: the two output lines printed by mlx90632_read(), formatted in memory
+ *
+ * The timer is the DWT cycle counter on Cortex-M targets that have it, k_cycle_get_32() on
+ * other Zephyr targets and clock_gettime(CLOCK_MONOTONIC) on host. The minimum cost of reading
+ * the timer is measured first and removed from every run.
+ * Bus stages use the installed MLXBus_s, compute stages use the prepared calibration MLX_KP,
+ * so mlx90632_init() (or mlx90632_readCalib()) must have run before.
+ *
+ * The following functions will be implemented:
+ * - mlx90632_bench_run() to time every stage
+ * - mlx90632_bench_print() to print the results table
+ * - mlx90632_bench_stage_name() to get the name of a stage
+ *
+ */
+
+#ifndef __MLX90632_BENCH_H__
+#define __MLX90632_BENCH_H__
+
+#include "mlx90632_port.h"
+#include "mlx90632.h"
+
+#define MLX90632_BENCH_MAX_SAMPLES 1000 /**< Maximum timed runs per stage */
+
+typedef enum mlx90632_bench_stage_e {
+    MLX90632_BENCH_I2C = 0,
+    MLX90632_BENCH_POLL,
+    MLX90632_BENCH_DECODE,
+    MLX90632_BENCH_AMBIENT,
+    MLX90632_BENCH_OBJECT,
+    MLX90632_BENCH_EMA,
+    MLX90632_BENCH_MEDIAN,
+    MLX90632_BENCH_KALMAN,
+    MLX90632_BENCH_FORMAT,
+    MLX90632_BENCH_STAGES,
+} mlx90632_bench_stage_t;
+
+typedef struct{
+    uint32_t samples;   /**< timed runs */
+    uint32_t errors;    /**< runs failed (bus stages only), not timed */
+    uint32_t min_ns;
+    uint32_t mean_ns;
+    uint32_t p99_ns;
+    uint32_t max_ns;
+}MLXBenchStage_s;
+
+typedef struct{
+    MLXBenchStage_s stage[MLX90632_BENCH_STAGES];
+    uint32_t timer_hz;      /**< frequency of the timer used */
+    uint32_t overhead_ns;   /**< cost of reading the timer, already removed from every stage */
+}MLXBench_s;
+
+/**
+ * @brief Time every stage of the measurement path
+ *
+ * @param iterations timed runs per stage, limited to MLX90632_BENCH_MAX_SAMPLES
+ * @param bench pointer to the results to fill
+ *
+ * @return int32_t 0 on success, -EIO if the RAM window could never be read (compute stages not run)
+ */
+int32_t mlx90632_bench_run(uint32_t iterations, MLXBench_s *bench);
+
+/**
+ * @brief Print the results table with printk()
+ *
+ * @param bench pointer to the results
+ *
+ * @return void
+ */
+void mlx90632_bench_print(const MLXBench_s *bench);
+
+/**
+ * @brief Get the name of a stage
+ *
+ * @param stage stage index
+ *
+ * @return const char* stage name, "?" if out of range
+ */
+const char *mlx90632_bench_stage_name(mlx90632_bench_stage_t stage);
+
+#endif /* __MLX90632_BENCH_H__ */
@@ -0,0 +1,91 @@
+/******************************************************************************
+ * Copyright (c) 2025 Marconatale Parise.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * You may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************/
+/**
+ * @file mlx90632_bus.h
+ * @brief this file contain the bus and timing interface used by the melexis library
+ *
+ * Every register access, sleep and timestamp of the library goes through a MLXBus_s, so the
+ * driver state machine and math run unchanged on target and on the host.
+ * Words are exchanged in cpu order, byte swapping of the i2c frames is done by the backend.
+ *
+ * Available backends:
+ * - mlx90632_bus_zephyr: i2c_transfer() on I2C_DEV, k_usleep(), k_uptime_ticks()
+ * - mlx90632_bus_linux: i2c-dev ioctl(I2C_RDWR), nanosleep(), clock_gettime(CLOCK_MONOTONIC)
+ *
+ * The default backend is the one of the platform being built, a different one (e.g. a fake
+ * bus in a host benchmark) is installed with mlx90632_bus_set().
+ *
+ * This header must not depend on Zephyr or on the rest of the library.
+ *
+ */
+
+#ifndef __MLX90632_BUS_H__
+#define __MLX90632_BUS_H__
+
+#include <stdint.h>
+
+#define MLX90632_I2C_ADDR   0x3A /**< Default 7-bit i2c address of the sensor */
+
+typedef struct{
+    int32_t (*read)(void *ctx, uint16_t reg, uint16_t *value);                      /**< read one word */
+    int32_t (*write)(void *ctx, uint16_t reg, uint16_t value);                      /**< write one word */
+    int32_t (*read_block)(void *ctx, uint16_t reg, uint16_t *value, uint16_t len);  /**< read len consecutive words */
+    void (*sleep_us)(void *ctx, uint32_t us);                                       /**< blocking sleep */
+    uint64_t (*now_us)(void *ctx);                                                  /**< monotonic time */
+    void *ctx;                                                                      /**< backend private data */
+}MLXBus_s;
+
+#ifdef __ZEPHYR__
+extern const MLXBus_s mlx90632_bus_zephyr;
+#else
+extern const MLXBus_s mlx90632_bus_linux;
+
+/**
+ * @brief Open the linux i2c-dev backend
+ *
+ * @param path i2c-dev node, e.g. "/dev/i2c-1"
+ * @param addr 7-bit i2c address of the sensor
+ *
+ * @return int32_t Returns 0 on success, or a negative error code on failure.
+ */
+int32_t mlx90632_bus_linux_open(const char *path, uint16_t addr);
+
+/**
+ * @brief Close the linux i2c-dev backend
+ *
+ * @return void
+ */
+void mlx90632_bus_linux_close(void);
+#endif
+
+/**
+ * @brief Install the bus used by the library
+ *
+ * @param bus pointer to the bus, NULL restores the platform default
+ *
+ * @return void
+ */
+void mlx90632_bus_set(const MLXBus_s *bus);
+
+/**
+ * @brief Get the bus used by the library
+ *
+ * @return const MLXBus_s* current bus
+ */
+const MLXBus_s *mlx90632_bus_get(void);
+
+#endif /* __MLX90632_BUS_H__ */
@@ -0,0 +1,107 @@
+/******************************************************************************
+ * Copyright (c) 2025 Marconatale Parise.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * You may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************/
+/**
+ * @file mlx90632_cache.h
+ * @brief this file contain the functions prototype to persist decoded melexis calibration
+ * in flash through Zephyr settings (NVS backend).
+ *
+ * The cached calibration is keyed by the sensor eeprom version and by a CRC (seed
+ * MLX90632_EE_SEED) of the chip ID / version words, so a warm boot only needs one short
+ * burst read to validate it. A CRC of the calibration eeprom words is stored with the record
+ * to avoid rewriting flash when the same calibration is read again.
+ *
+ * Every sensor has its own record, keyed by an id given by the caller (the i2c address of the
+ * sensor, so sensors sharing a board keep separate calibrations): the record of id 0x3A is
+ * stored under "mlx90632/calib/3a". Up to MLX90632_CACHE_SLOTS sensors are kept in RAM.
+ *
+ * The following functions will be implemented:
+ * - mlx90632_cache_load() to validate the sensor fingerprint and load cached calibration
+ * - mlx90632_cache_store() to save decoded calibration for the last read fingerprint
+ * - mlx90632_cache_invalidate() to drop the cached calibration
+ *
+ * If CONFIG_SETTINGS is not enabled the functions do nothing and the calibration is always
+ * read from the sensor eeprom.
+ *
+ * @author Marconatale Parise
+ * @date 09 June 2025
+ *
+ */
+
+#ifndef __MLX90632_CACHE_H__
+#define __MLX90632_CACHE_H__
+
+#include "mlx90632.h"
+
+#define MLX90632_CACHE_KEY "mlx90632/calib" /**< Settings key prefix, followed by "/<id in hex>" */
+#define MLX90632_CACHE_SLOTS 4 /**< Sensors whose record and fingerprint are kept in RAM */
+#define MLX90632_EE_FINGERPRINT_START MLX90632_EE_ID0 /**< First word of the fingerprint window */
+#define MLX90632_EE_FINGERPRINT_LEN (MLX90632_EE_VERSION - MLX90632_EE_ID0 + 1) /**< Words in the fingerprint window */
+
+typedef struct{
+    uint16_t ee_version;
+    uint16_t fp_crc;
+    uint16_t ee_crc;
+    MLXCalib_s calib;
+}MLXCalibCache_s;
+
+/**
+ * @brief Load cached calibration
+ *
+ * Read the chip ID / eeprom version window with one burst, compute its CRC and compare it with
+ * the record of the sensor stored in flash. On match the cached calibration is copied into calib.
+ *
+ * @param id sensor id, e.g. its i2c address
+ * @param calib pointer to the calibration struct to fill
+ *
+ * @return int32_t 0 if cached calibration was loaded, -ENOENT if the cache does not match
+ * the sensor, -ENOMEM if MLX90632_CACHE_SLOTS other sensors are cached, <0 on other errors
+ */
+int32_t mlx90632_cache_load(uint16_t id, MLXCalib_s *calib);
+
+/**
+ * @brief Store calibration in cache
+ *
+ * Save the calibration decoded from ee for the fingerprint read by the last
+ * mlx90632_cache_load() of the same id. Flash is written only if the eeprom CRC or the
+ * fingerprint changed.
+ *
+ * @param id sensor id given to mlx90632_cache_load()
+ * @param ee pointer to the eeprom image the calibration was decoded from
+ * @param calib pointer to the decoded calibration
+ *
+ * @return int32_t 0 if successfully stored or already up to date, <0 if something went wrong
+ */
+int32_t mlx90632_cache_store(uint16_t id, const MLXEeprom_s *ee, const MLXCalib_s *calib);
+
+/**
+ * @brief Invalidate cached calibration
+ *
+ * Delete the calibration record of the sensor so that next mlx90632_init() reads eeprom again.
+ * Must be called after calibration words (e.g. Ha/Hb) are rewritten in the sensor eeprom.
+ *
+ * @param id sensor id
+ *
+ * @return int32_t 0 if successfully deleted, <0 if something went wrong
+ */
+int32_t mlx90632_cache_invalidate(uint16_t id);
+
+#ifdef TEST
+/* Forget every record kept in RAM, next load reads them from flash again */
+void mlx90632_cache_reset(void);
+#endif
+
+#endif /* __MLX90632_CACHE_H__ */
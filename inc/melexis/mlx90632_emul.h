@@ -0,0 +1,113 @@
+/******************************************************************************
+ * Copyright (c) 2025 Marconatale Parise.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * You may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************/
+/**
+ * @file mlx90632_emul.h
+ * @brief this file contain the i2c emulator of the melexis sensor for native_posix
+ *
+ * The emulator models the register map of mlx90632.h:
+ * - EEPROM with ID, version, calibration, customer Ha/Hb, i2c address and measurement table,
+ *   writable after the 0x554C unlock key with erase before write and EE_BUSY timing
+ * - CTRL power modes (halt, sleeping step, step, continuous), SOC and SOB
+ * - STATUS busy, EE busy, cycle position and data ready
+ * - RAM_4..RAM_9 of the medical table
+ * - addressed reset command
+ *
+ * Each cycle position takes (MLX90632_MEAS_MAX_TIME >> refresh rate) ms, with the refresh rate
+ * read from EE_MEDICAL_MEAS1. RAM values are computed from a temperature profile by inverting
+ * the ambient and object formulas with the emulated calibration, so the driver output can be
+ * compared with the profile.
+ *
+ * The emulator also counts bus traffic and the latency from data ready to RAM read.
+ *
+ * The following functions will be implemented:
+ * - mlx90632_emul_set_profile() to install a temperature profile
+ * - mlx90632_emul_set_nack() to make every transfer fail (fault injection)
+ * - mlx90632_emul_get_stats() to get bus traffic and latency statistics
+ * - mlx90632_emul_reset_stats() to reset the statistics
+ *
+ */
+
+#ifndef __MLX90632_EMUL_H__
+#define __MLX90632_EMUL_H__
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <zephyr/drivers/emul.h>
+
+/**
+ * @brief Temperature profile driving the emulated sensor
+ *
+ * @param t_us time since emulator init in us
+ * @param ambient pointer to the ambient temperature to fill in degree Celsius
+ * @param object pointer to the object temperature to fill in degree Celsius
+ */
+typedef void (*MLXEmulProfile_t)(uint64_t t_us, double *ambient, double *object);
+
+typedef struct{
+    uint32_t transfers;     /**< i2c transfers addressed to the sensor */
+    uint32_t reads;         /**< register reads (one per burst) */
+    uint32_t writes;        /**< register writes */
+    uint32_t words_read;    /**< 16-bit words returned */
+    uint32_t status_reads;  /**< reads of the status register */
+    uint32_t nacks;         /**< transfers refused */
+    uint32_t samples;       /**< cycle positions completed */
+    uint32_t samples_read;  /**< completed cycle positions whose RAM was read */
+    uint32_t latency_min_us; /**< data ready to first RAM read, minimum */
+    uint32_t latency_max_us; /**< data ready to first RAM read, maximum */
+    uint64_t latency_total_us; /**< data ready to first RAM read, sum over samples_read */
+}MLXEmulStats_s;
+
+/**
+ * @brief Install a temperature profile
+ *
+ * @param target emulator instance
+ * @param profile profile function, NULL restores the default profile
+ *
+ * @return void
+ */
+void mlx90632_emul_set_profile(const struct emul *target, MLXEmulProfile_t profile);
+
+/**
+ * @brief Make every transfer addressed to the sensor fail
+ *
+ * @param target emulator instance
+ * @param nack true to refuse transfers
+ *
+ * @return void
+ */
+void mlx90632_emul_set_nack(const struct emul *target, bool nack);
+
+/**
+ * @brief Get bus traffic and latency statistics
+ *
+ * @param target emulator instance
+ * @param stats pointer to the statistics to fill
+ *
+ * @return void
+ */
+void mlx90632_emul_get_stats(const struct emul *target, MLXEmulStats_s *stats);
+
+/**
+ * @brief Reset bus traffic and latency statistics
+ *
+ * @param target emulator instance
+ *
+ * @return void
+ */
+void mlx90632_emul_reset_stats(const struct emul *target);
+
+#endif /* __MLX90632_EMUL_H__ */
@@ -0,0 +1,115 @@
+/******************************************************************************
+ * Copyright (c) 2025 Marconatale Parise.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * You may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************/
+/**
+ * @file mlx90632_filter.h
+ * @brief this file contain the filter stage between conversion and publication of temperatures
+ *
+ * One MLXFilter_s per sensor filters ambient and object temperature with one of:
+ * - MLX90632_FILTER_EMA: exponential moving average, y += alpha * (x - y)
+ * - MLX90632_FILTER_MEDIAN: median of the last median_len samples (odd, up to
+ *   MLX90632_FILTER_MEDIAN_MAX), rejects spikes shorter than median_len / 2 samples
+ * - MLX90632_FILTER_KALMAN: scalar Kalman filter of a random walk, process noise q and
+ *   measurement noise r in degC^2 per sample; the gain settles to the EMA alpha that is optimal
+ *   for that noise ratio
+ *
+ * State is a few floats per channel, in the struct: no allocation, constant time per sample.
+ * The first sample after init or reset is passed through and starts the state.
+ * Cost per sample is measured by mlx90632_bench_run() (stages ema, median, kalman).
+ *
+ * The following functions will be implemented:
+ * - mlx90632_filter_init() to set the filter type and parameters
+ * - mlx90632_filter_reset() to restart from the next sample
+ * - mlx90632_filter_apply() to filter one ambient and object pair in place
+ *
+ */
+
+#ifndef __MLX90632_FILTER_H__
+#define __MLX90632_FILTER_H__
+
+#include "mlx90632.h"
+
+#define MLX90632_FILTER_MEDIAN_MAX  7       /**< Longest median window */
+#define MLX90632_FILTER_EMA_ALPHA   0.25f   /**< Default EMA weight of the new sample */
+#define MLX90632_FILTER_MEDIAN_LEN  5       /**< Default median window */
+#define MLX90632_FILTER_KALMAN_Q    1e-4f   /**< Default process noise, degC^2 per sample */
+#define MLX90632_FILTER_KALMAN_R    4e-3f   /**< Default measurement noise, degC^2 */
+
+typedef enum mlx90632_filter_e {
+    MLX90632_FILTER_NONE = 0,
+    MLX90632_FILTER_EMA = 1,
+    MLX90632_FILTER_MEDIAN = 2,
+    MLX90632_FILTER_KALMAN = 3,
+} mlx90632_filter_t;
+
+typedef struct{
+    mlx90632_filter_t type;
+    float ema_alpha;            /**< weight of the new sample, 0 to 1 */
+    uint8_t median_len;         /**< odd window length, 1 to MLX90632_FILTER_MEDIAN_MAX */
+    float kalman_q;             /**< process noise variance */
+    float kalman_r;             /**< measurement noise variance */
+}MLXFilterConfig_s;
+
+typedef struct{
+    bool primed;                /**< a sample was received since init or reset */
+    float value;                /**< EMA and Kalman estimate */
+    float p;                    /**< Kalman estimate variance */
+    float window[MLX90632_FILTER_MEDIAN_MAX];
+    uint8_t next;               /**< median window slot of the next sample */
+    uint8_t count;              /**< samples in the median window */
+}MLXFilterChannel_s;
+
+typedef struct{
+    MLXFilterConfig_s cfg;
+    MLXFilterChannel_s ambient;
+    MLXFilterChannel_s object;
+}MLXFilter_s;
+
+/**
+ * @brief Set the filter type and parameters
+ *
+ * An even or too long median window is rounded down to the nearest valid odd length.
+ *
+ * @param filter filter of one sensor
+ * @param cfg configuration, NULL for MLX90632_FILTER_NONE
+ *
+ * @return void
+ */
+void mlx90632_filter_init(MLXFilter_s *filter, const MLXFilterConfig_s *cfg);
+
+/**
+ * @brief Drop the state, the next sample starts the filter again
+ *
+ * Used after a gap in the samples (acquisition restart, sensor reset) so that old values do
+ * not leak into the new ones.
+ *
+ * @param filter filter of one sensor
+ *
+ * @return void
+ */
+void mlx90632_filter_reset(MLXFilter_s *filter);
+
+/**
+ * @brief Filter one ambient and object pair in place
+ *
+ * @param filter filter of one sensor
+ * @param temp temperatures to filter
+ *
+ * @return void
+ */
+void mlx90632_filter_apply(MLXFilter_s *filter, MLXTemp_s *temp);
+
+#endif /* __MLX90632_FILTER_H__ */
@@ -22,11 +22,20 @@
  * The following functions will be implemented:
  * - i2c_init() to initialize the i2c peripheral
  * - i2c_scan() to scan for i2c devices on the bus
- * - ob1203_i2c_read() to read a single byte from a specific register address
- * - ob1203_i2c_read_block() to read a block of data from a specific register address
+ * - mlx90632_i2c_read() to read a single word from a specific register address
+ * - mlx90632_i2c_read_block() to read a block of words from a specific register address
  * - ob1203_i2c_write() to write a single byte to a specific register address
  * - i2c_ob1203_getReg() to print the content of a register at the specified address
  * - get_OB1203_error() to get the current error status of the OB1203 sensor
+ * - mlx90632_i2c_get_stats() to get per register class transaction statistics
+ * - mlx90632_i2c_reset_stats() to reset transaction statistics
+ * - mlx90632_i2c_dump_stats() to print transaction statistics
+ *
+ * When MLX_BUS_STATS is set every transaction is timed with the bus clock and accounted to the
+ * class of its register (eeprom, ram, control, status): count, bytes on the wire, log2 latency
+ * histogram, NACKs, timeouts and other errors. Transfers run on the acquisition thread and on
+ * the sensor workqueue, and the statistics are read from the stats timer, so they are updated
+ * and copied under a spinlock: a reader never sees a transaction half accounted.
  * 
  * @author Marconatale Parise
  * @date 09 June 2025
@@ -36,16 +45,41 @@
 #ifndef I2C_GEN_H
 #define I2C_GEN_H
 
-#include <zephyr/kernel.h>
-#include <zephyr/device.h>
-#include <zephyr/drivers/i2c.h>
-#include "i2c_dt.h"
+#include "mlx90632_port.h"
+#include "mlx90632_bus.h"
 #include "common.h"
 
 
 #define MLX90632_NODE DT_NODELABEL(mlx90632)
 #define MLX90632_ADDR DT_REG_ADDR(MLX90632_NODE)
 
+#define MLX90632_BUS_HIST_BUCKETS 16 /**< log2 latency buckets: 0 us, [1,2) us, [2,4) us ... [16.4 ms, inf) */
+
+typedef enum mlx90632_reg_class_e {
+    MLX90632_REG_CLASS_EEPROM = 0,  /**< 0x2400..0x27FF */
+    MLX90632_REG_CLASS_RAM,         /**< 0x4000..0x4FFF */
+    MLX90632_REG_CLASS_CTRL,        /**< 0x3000..0x3FFE, control and command registers */
+    MLX90632_REG_CLASS_STATUS,      /**< 0x3FFF, data ready polling */
+    MLX90632_REG_CLASS_OTHER,
+    MLX90632_REG_CLASSES,
+} mlx90632_reg_class_t;
+
+typedef struct{
+    uint32_t reads;         /**< read transactions (single or block) */
+    uint32_t writes;        /**< write transactions */
+    uint32_t bytes;         /**< bytes on the wire, register address included, i2c address excluded */
+    uint32_t nacks;         /**< failed with -EIO, -ENXIO or -EREMOTEIO */
+    uint32_t timeouts;      /**< failed with -ETIMEDOUT or -EAGAIN */
+    uint32_t errors;        /**< failed with any other code */
+    uint32_t latency_max_us;
+    uint64_t latency_total_us;
+    uint32_t hist[MLX90632_BUS_HIST_BUCKETS]; /**< latency of every transaction, failed ones included */
+}MLXBusClassStats_s;
+
+typedef struct{
+    MLXBusClassStats_s cls[MLX90632_REG_CLASSES];
+}MLXBusStats_s;
+
 extern uint8_t error_melexis90632;
 
 
@@ -62,6 +96,21 @@ extern uint8_t error_melexis90632;
  */
 extern int32_t mlx90632_i2c_read(int16_t register_address, uint16_t *value);
 
+/**
+ * @brief Read a block of consecutive 16-bit registers
+ *
+ * Reads len consecutive 16-bit words starting from the specified register address of the
+ * Melexis sensor in a single i2c transaction. The sensor auto-increments the address so the
+ * register address is sent only once. Each word is converted from big-endian to cpu order.
+ *
+ * @param register_address 16-bit value that indicates the first register address to read from
+ * @param value Pointer to an array of at least len words where the read values will be stored
+ * @param len Number of 16-bit words to read
+ *
+ * @return int32_t Returns 0 on success, or a negative error code on failure.
+ */
+extern int32_t mlx90632_i2c_read_block(int16_t register_address, uint16_t *value, uint16_t len);
+
 /**
  * @brief Write a single byte to a specific register address
  *
@@ -85,4 +134,30 @@ extern int32_t mlx90632_i2c_write(int16_t register_address, uint16_t value);
  */
 extern uint8_t get_melexis_error(void);
 
+/**
+ * @brief Get per register class transaction statistics
+ *
+ * @param stats pointer to the statistics to fill, all zero when MLX_BUS_STATS is not set
+ *
+ * @return void
+ */
+void mlx90632_i2c_get_stats(MLXBusStats_s *stats);
+
+/**
+ * @brief Reset transaction statistics
+ *
+ * @return void
+ */
+void mlx90632_i2c_reset_stats(void);
+
+/**
+ * @brief Print transaction statistics with printk()
+ *
+ * One line per register class with counts, bytes, errors, mean/max latency and the
+ * non-empty histogram buckets.
+ *
+ * @return void
+ */
+void mlx90632_i2c_dump_stats(void);
+
 #endif
\ No newline at end of file
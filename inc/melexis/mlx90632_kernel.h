@@ -0,0 +1,388 @@
+/**
+ * @file mlx90632_kernel.h
+ * @brief MLX90632 single-precision and fixed-point temperature kernels
+ * @internal
+ *
+ * @copyright (c) 2025 Marconatale Parise.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @endinternal
+ *
+ * @details
+ * The double kernels in mlx90632.c are the reference implementation. On the Cortex-M33 the FPU
+ * is single precision only, so double math is emulated in software. This module provides:
+ * - double kernels on the prepared calibration
+ * - float32 kernels using the hardware FPU
+ * - Q-format fixed-point kernels using only 64-bit integer math
+ *
+ * All kernels take a prepared calibration (MLXPrepared_s) built once by mlx90632_prepare() at
+ * init and on emissivity change, holding the reciprocals and products of the calibration
+ * constants so that no kernel divides by a calibration constant.
+ *
+ * The kernel used by mlx90632_calc_temp_kernel() is selected at build time with MLX_KERNEL
+ * (see common.h).
+ *
+ * @{
+ */
+#ifndef _MLX90632_KERNEL_
+#define _MLX90632_KERNEL_
+
+#include "mlx90632.h"
+
+#define MLX_KERNEL_DOUBLE   0 /**< Double precision reference kernel */
+#define MLX_KERNEL_FLOAT    1 /**< Single precision kernel */
+#define MLX_KERNEL_FIXED    2 /**< Q-format fixed-point kernel */
+
+#ifndef MLX_KERNEL
+#define MLX_KERNEL MLX_KERNEL_DOUBLE
+#endif
+
+#define MLX_SOLVER_FIXED    0 /**< Three iterations seeded at 25 degC, as the reference */
+#define MLX_SOLVER_WARM     1 /**< Seeded from the previous sample, stops on tolerance */
+
+#ifndef MLX_SOLVER
+#define MLX_SOLVER MLX_SOLVER_FIXED
+#endif
+
+#ifndef MLX_SOLVER_TOLERANCE
+#define MLX_SOLVER_TOLERANCE 0.001 /**< Object temperature convergence tolerance in degC */
+#endif
+
+#define MLX90632_FIXED_ITER       3 /**< Iterations of the reference object solver */
+#define MLX90632_SOLVER_MAX_ITER  8 /**< Upper bound of iterations of the warm-started solver */
+
+/* Fixed-point formats used by the Q kernel */
+#define MLX90632_Q_TEMP     16 /**< Temperature fraction bits inside the Q kernel */
+#define MLX90632_Q_TK0      17901158LL /**< 273.15 in Q16 */
+#define MLX90632_Q_T25      ((int64_t)25 << 16) /**< 25.0 in Q16 */
+
+#define MLX90632_AMB_SCALE  (524288.0 / MLX90632_REF_3) /**< 2^19 / 12 scaling of AMB and Sto */
+
+/* Max error against the double reference, over every RAM_6, RAM_9 and object word giving an
+ * ambient in -40..85 degC and an object in -70..380 degC (host test mlx90632_test_kernel_sweep) */
+#define MLX90632_KERNEL_F_AMB_ERR   0.01  /**< float32 ambient, degC */
+#define MLX90632_KERNEL_F_OBJ_ERR   0.001 /**< float32 object, degC */
+#define MLX90632_KERNEL_Q_AMB_ERR   0.002 /**< fixed-point ambient, degC, mC rounding included */
+#define MLX90632_KERNEL_Q_OBJ_ERR   0.002 /**< fixed-point object, degC, mC rounding included */
+
+/* Derived constants for the double kernel */
+typedef struct{
+    double amb_scale;   /**< 2^19 / 12 */
+    double Gb_12;       /**< Gb / 12 */
+    double Ka_12;       /**< Ka / 12 */
+    double P_R;
+    double inv_PG;      /**< 1 / P_G */
+    double P_T;
+    double P_O;
+    double Eb;
+    double inv_Ea;      /**< 1 / Ea */
+    double inv_emiFaHa; /**< 1 / (emissivity * Fa * Ha) */
+    double Ga;
+    double Fb;
+    double Hb;
+}MLXPrepD_s;
+
+/* Derived constants for the float kernel */
+typedef struct{
+    float amb_scale;
+    float Gb_12;
+    float Ka_12;
+    float P_R;
+    float inv_PG;
+    float P_T;
+    float P_O;
+    float Eb;
+    float inv_Ea;
+    float inv_emiFaHa;
+    float Ga;
+    float Fb;
+    float Hb;
+}MLXPrepF_s;
+
+/* Calibration constants in fixed-point, values are eeprom raw scaling (Qn = value * 2^n) */
+typedef struct{
+    int64_t P_R_q8;
+    int64_t P_G_q20;
+    int64_t P_T_q44;
+    int64_t P_O_q8;
+    int64_t Ea_q16;
+    int64_t Eb_q8;
+    int64_t Fb_q36;
+    int64_t Ga_q36;
+    int64_t Gb_q10;
+    int64_t Ka_q10;
+    int64_t Hb_q16;
+    int64_t K_q8;       /**< 1 / (emissivity * Fa * Ha) */
+}MLXCalibQ_s;
+
+/* Prepared calibration: everything that depends only on calibration and emissivity */
+typedef struct{
+    MLXPrepD_s d;
+    MLXPrepF_s f;
+    MLXCalibQ_s q;
+}MLXPrepared_s;
+
+/* Fixed-point result of the fused Q kernel */
+typedef struct{
+    int32_t ambient_mc; /**< ambient temperature in milliCelsius */
+    int32_t object_mc;  /**< object temperature in milliCelsius */
+}MLXTempQ_s;
+
+/* Iteration statistics of the warm-started solver */
+typedef struct{
+    uint32_t samples;       /**< solved samples */
+    uint32_t iterations;    /**< total iterations, mean = iterations / samples */
+    uint32_t max;           /**< highest iterations used by one sample */
+    uint32_t limit_reached; /**< samples stopped by max_iter before reaching the tolerance */
+    uint32_t hist[MLX90632_SOLVER_MAX_ITER + 1]; /**< samples per iterations used */
+}MLXSolverStats_s;
+
+/* Per-sensor state of the warm-started solver */
+typedef struct{
+    double object;          /**< last object temperature, seed of the next solve */
+    bool valid;             /**< object holds a usable seed */
+    double tolerance;       /**< stop when the change between iterations is below, in degC */
+    uint8_t max_iter;       /**< iteration limit, at most MLX90632_SOLVER_MAX_ITER */
+    MLXSolverStats_s stats;
+}MLXSolver_s;
+
+extern MLXPrepared_s MLX_KP;
+extern MLXSolver_s MLX_SV;
+
+/**
+ * @brief Prepare calibration for the kernels
+ *
+ * Compute products, reciprocals and fixed-point conversions that depend only on calibration
+ * and emissivity, so that kernels do no division by calibration constants.
+ * Called at init and each time calibration or emissivity change.
+ *
+ * @param calib pointer to the decoded calibration
+ * @param emi object emissivity
+ * @param prep pointer to the prepared calibration to fill
+ *
+ * @return void
+ */
+void mlx90632_prepare(const MLXCalib_s *calib, double emi, MLXPrepared_s *prep);
+
+/**
+ * @brief Prepare MLX_KP from MLX_K and emissivity
+ *
+ * The prepared calibration is built aside and published in MLX_KP under a spinlock, so a
+ * concurrent mlx90632_kernel_snapshot() never sees it half written.
+ *
+ * @param no_data
+ *
+ * @return void
+ */
+void mlx90632_kernel_prepare(void);
+
+/**
+ * @brief Copy MLX_KP under the lock taken by mlx90632_kernel_prepare()
+ *
+ * @param prep pointer to the copy to fill
+ *
+ * @return void
+ */
+void mlx90632_kernel_snapshot(MLXPrepared_s *prep);
+
+/**
+ * @brief Calculate ambient temperature in double precision with prepared calibration
+ *
+ * @param raw pointer to the raw record
+ * @param prep pointer to the prepared calibration
+ *
+ * @return double temperature value in degree Celsius
+ */
+double mlx90632_calc_temp_ambient_d(const MLXTempRaw_s *raw, const MLXPrepared_s *prep);
+
+/**
+ * @brief Calculate object temperature in double precision with prepared calibration
+ *
+ * @param raw pointer to the raw record
+ * @param prep pointer to the prepared calibration
+ *
+ * @return double temperature value in degree Celsius
+ */
+double mlx90632_calc_temp_object_d(const MLXTempRaw_s *raw, const MLXPrepared_s *prep);
+
+/**
+ * @brief Calculate ambient temperature in single precision
+ *
+ * @param raw pointer to the raw record
+ * @param prep pointer to the prepared calibration
+ *
+ * @return float temperature value in degree Celsius
+ */
+float mlx90632_calc_temp_ambient_f(const MLXTempRaw_s *raw, const MLXPrepared_s *prep);
+
+/**
+ * @brief Calculate object temperature in single precision
+ *
+ * Same three iterations of the double reference using sqrtf().
+ *
+ * @param raw pointer to the raw record
+ * @param prep pointer to the prepared calibration
+ *
+ * @return float temperature value in degree Celsius
+ */
+float mlx90632_calc_temp_object_f(const MLXTempRaw_s *raw, const MLXPrepared_s *prep);
+
+/**
+ * @brief Calculate ambient temperature in fixed-point
+ *
+ * @param raw pointer to the raw record
+ * @param prep pointer to the prepared calibration
+ *
+ * @return int32_t temperature value in milliCelsius
+ */
+int32_t mlx90632_calc_temp_ambient_q(const MLXTempRaw_s *raw, const MLXPrepared_s *prep);
+
+/**
+ * @brief Calculate object temperature in fixed-point
+ *
+ * Same three iterations of the double reference using integer square root.
+ *
+ * @param raw pointer to the raw record
+ * @param prep pointer to the prepared calibration
+ *
+ * @return int32_t temperature value in milliCelsius
+ */
+int32_t mlx90632_calc_temp_object_q(const MLXTempRaw_s *raw, const MLXPrepared_s *prep);
+
+/**
+ * @brief Calculate ambient and object temperature in double precision in a single pass
+ *
+ * VR_Ta and AMB are computed once and shared by the ambient and object formulas.
+ * Pure function: no global is read or written.
+ *
+ * @param raw pointer to the raw record
+ * @param prep pointer to the prepared calibration
+ * @param temp pointer to the result in degree Celsius
+ *
+ * @return void
+ */
+void mlx90632_calc_temp_d(const MLXTempRaw_s *raw, const MLXPrepared_s *prep, MLXTemp_s *temp);
+
+/**
+ * @brief Calculate ambient and object temperature in single precision in a single pass
+ *
+ * @param raw pointer to the raw record
+ * @param prep pointer to the prepared calibration
+ * @param temp pointer to the result in degree Celsius
+ *
+ * @return void
+ */
+void mlx90632_calc_temp_f(const MLXTempRaw_s *raw, const MLXPrepared_s *prep, MLXTemp_s *temp);
+
+/**
+ * @brief Calculate ambient and object temperature in fixed-point in a single pass
+ *
+ * @param raw pointer to the raw record
+ * @param prep pointer to the prepared calibration
+ * @param temp pointer to the result in milliCelsius
+ *
+ * @return void
+ */
+void mlx90632_calc_temp_q(const MLXTempRaw_s *raw, const MLXPrepared_s *prep, MLXTempQ_s *temp);
+
+/**
+ * @brief Calculate ambient and object temperature with the kernel selected by MLX_KERNEL
+ *
+ * Pure function usable from batch and multi-sensor paths, each with its own prepared
+ * calibration.
+ *
+ * @param raw pointer to the raw record
+ * @param prep pointer to the prepared calibration
+ * @param temp pointer to the result in degree Celsius
+ *
+ * @return void
+ */
+void mlx90632_calc_temp(const MLXTempRaw_s *raw, const MLXPrepared_s *prep, MLXTemp_s *temp);
+
+/**
+ * @brief Initialize a warm-started solver state
+ *
+ * @param solver pointer to the solver state
+ * @param tolerance convergence tolerance in degC
+ * @param max_iter iteration limit, clamped to 1..MLX90632_SOLVER_MAX_ITER
+ *
+ * @return void
+ */
+void mlx90632_solver_init(MLXSolver_s *solver, double tolerance, uint8_t max_iter);
+
+/**
+ * @brief Drop the seed so that the next solve starts from 25 degC
+ *
+ * To be called when the sample stream is interrupted (e.g. acquisition restart).
+ *
+ * @param solver pointer to the solver state
+ *
+ * @return void
+ */
+void mlx90632_solver_invalidate(MLXSolver_s *solver);
+
+/**
+ * @brief Get iteration statistics of a solver
+ *
+ * @param solver pointer to the solver state
+ * @param stats pointer to the statistics to fill
+ *
+ * @return void
+ */
+void mlx90632_solver_get_stats(const MLXSolver_s *solver, MLXSolverStats_s *stats);
+
+/**
+ * @brief Reset iteration statistics of a solver
+ *
+ * @param solver pointer to the solver state
+ *
+ * @return void
+ */
+void mlx90632_solver_reset_stats(MLXSolver_s *solver);
+
+/**
+ * @brief Calculate ambient and object temperature with the warm-started solver
+ *
+ * Same single pass of mlx90632_calc_temp(), but the object iteration starts from the previous
+ * object temperature of this solver and stops as soon as the change between two iterations is
+ * below the tolerance. At high sample rate consecutive samples are close and most converge in one
+ * or two iterations. A sample counts in limit_reached only if its last allowed iteration still
+ * changed by the tolerance or more.
+ *
+ * @param raw pointer to the raw record
+ * @param prep pointer to the prepared calibration
+ * @param solver pointer to the solver state of this sensor, updated
+ * @param temp pointer to the result in degree Celsius
+ *
+ * @return void
+ */
+void mlx90632_calc_temp_warm(const MLXTempRaw_s *raw, const MLXPrepared_s *prep, MLXSolver_s *solver, MLXTemp_s *temp);
+
+/**
+ * @brief Calculate ambient and object temperature with the selected kernel
+ *
+ * Uses a snapshot of the prepared calibration MLX_KP taken with mlx90632_kernel_snapshot(), so
+ * it is safe against a calibration rebuilt by another thread, and the solver MLX_SV when
+ * MLX_SOLVER is MLX_SOLVER_WARM.
+ *
+ * @param raw pointer to the raw record
+ * @param temp pointer to the result in degree Celsius
+ *
+ * @return void
+ */
+void mlx90632_calc_temp_kernel(const MLXTempRaw_s *raw, MLXTemp_s *temp);
+
+///@}
+
+#endif
@@ -0,0 +1,107 @@
+/******************************************************************************
+ * Copyright (c) 2025 Marconatale Parise.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * You may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************/
+/**
+ * @file mlx90632_port.h
+ * @brief this file contain the few kernel services used by the melexis library outside the bus
+ *
+ * On Zephyr (__ZEPHYR__ defined by the build system) the kernel headers are used as is.
+ * On a host build the same names are mapped on C11 atomics and libc, so that the library
+ * sources compile unchanged:
+ * - atomic_t, atomic_get(), atomic_set(), atomic_inc() used by the sample ring
+ * - struct k_spinlock, k_spin_lock() and k_spin_unlock() guarding the prepared calibration
+ *   and the bus statistics
+ * - printk() used by register dumps
+ * - BIT(), MAX(), MIN() and BITS_PER_LONG from sys/util.h
+ * - k_uptime_get_32() used by LOG() timestamps
+ * - LOG_MODULE_REGISTER() and LOG_MODULE_DECLARE(), empty as LOG() prints directly
+ *
+ * Bus access and sleeping go through mlx90632_bus.h, not through this file.
+ *
+ */
+
+#ifndef __MLX90632_PORT_H__
+#define __MLX90632_PORT_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+
+#ifdef __ZEPHYR__
+
+#include <zephyr/kernel.h>
+
+#else
+
+#include <errno.h>
+#include <stdatomic.h>
+#include <time.h>
+
+typedef long atomic_val_t;
+typedef atomic_long atomic_t;
+
+#define atomic_get(target)          atomic_load((target))
+#define atomic_set(target, value)   atomic_exchange((target), (value))
+#define atomic_inc(target)          atomic_fetch_add((target), 1)
+
+struct k_spinlock{
+    atomic_bool locked;
+};
+
+typedef struct{
+    int key;
+}k_spinlock_key_t;
+
+static inline k_spinlock_key_t k_spin_lock(struct k_spinlock *l){
+    k_spinlock_key_t key = {0};
+
+    while (atomic_exchange_explicit(&l->locked, true, memory_order_acquire))
+        ;
+    return key;
+}
+
+static inline void k_spin_unlock(struct k_spinlock *l, k_spinlock_key_t key){
+    atomic_store_explicit(&l->locked, false, memory_order_release);
+}
+
+#define printk printf
+
+#ifndef BIT
+#define BIT(n) (1UL << (n))
+#endif
+#ifndef MAX
+#define MAX(a, b) (((a) > (b)) ? (a) : (b))
+#endif
+#ifndef MIN
+#define MIN(a, b) (((a) < (b)) ? (a) : (b))
+#endif
+#ifndef BITS_PER_LONG
+#define BITS_PER_LONG (__SIZEOF_LONG__ * 8)
+#endif
+
+#define LOG_MODULE_REGISTER(...)
+#define LOG_MODULE_DECLARE(...)
+
+static inline uint32_t k_uptime_get_32(void){
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t)((uint64_t)ts.tv_sec * 1000U + (uint64_t)ts.tv_nsec / 1000000U);
+}
+
+#endif /* __ZEPHYR__ */
+
+#endif /* __MLX90632_PORT_H__ */
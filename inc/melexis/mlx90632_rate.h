@@ -0,0 +1,151 @@
+/******************************************************************************
+ * Copyright (c) 2025 Marconatale Parise.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * You may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************/
+/**
+ * @file mlx90632_rate.h
+ * @brief this file contain the adaptive refresh rate controller
+ *
+ * The controller looks at the object temperature slope, measured over windows of window_ms so
+ * that conversion noise at high refresh rates does not look like a signal change:
+ * - slope above up_milli_per_s: the rate jumps to max_rate, to follow the event
+ * - slope below down_milli_per_s for calm_windows windows in a row: the rate steps down by one,
+ *   at most once every hold_ms
+ * - in between: the rate is kept (hysteresis)
+ *
+ * Every change erases and programs the refresh rate words of the measurement table
+ * (mlx90632_set_refresh_rate(): MEAS1 and MEAS2, three words in extended range), and EEPROM
+ * endurance is limited. Two limits apply to every change, step ups included:
+ * - min_change_ms between two changes, so at most 3600000 / min_change_ms changes per hour;
+ *   steps down also wait hold_ms and a step up always follows a step down, so the hourly bound
+ *   is the lower of that and 2 * 3600000 / MAX(hold_ms, calm_windows * window_ms)
+ * - max_changes per controller, i.e. per boot: once spent the rate stays where it is
+ * The price is latency: an event starting less than min_change_ms after the last change is
+ * followed at the old rate until the interval ends. With the defaults (10 s, 100 changes) a
+ * boot costs each word at most 100 erase/write cycles, to be weighed against the endurance in
+ * the datasheet and the expected number of boots.
+ *
+ * If the caller fails to apply a rate it gives the rate in use back with mlx90632_rate_sync(),
+ * so the controller does not drift from the sensor.
+ *
+ * The controller only decides: the caller applies the returned rate from the thread that owns
+ * the bus. It does no i2c access and compiles on the host too.
+ *
+ * The following functions will be implemented:
+ * - mlx90632_rate_init() to set the configuration and the current rate
+ * - mlx90632_rate_update() to feed one object temperature and get the rate to use
+ * - mlx90632_rate_sync() to set back the rate in use after a failed change
+ * - mlx90632_rate_get_stats() to get the number of changes and the last slope
+ *
+ */
+
+#ifndef __MLX90632_RATE_H__
+#define __MLX90632_RATE_H__
+
+#include "mlx90632.h"
+
+#define MLX90632_RATE_WINDOW_MS     1000   /**< Default slope window */
+#define MLX90632_RATE_UP_MILLI      500    /**< Default slope to jump to max rate, in mdegC/s */
+#define MLX90632_RATE_DOWN_MILLI    100    /**< Default slope below which the signal is calm, in mdegC/s */
+#define MLX90632_RATE_CALM_WINDOWS  10     /**< Default calm windows before a step down */
+#define MLX90632_RATE_HOLD_MS       60000  /**< Default minimum time between two steps down */
+#define MLX90632_RATE_MIN_CHANGE_MS 10000  /**< Default minimum time between two changes, steps up included */
+#define MLX90632_RATE_MAX_CHANGES   100    /**< Default changes per controller (per boot) */
+
+typedef struct{
+    mlx90632_meas_t min_rate;   /**< rate of a stable signal */
+    mlx90632_meas_t max_rate;   /**< rate during events */
+    uint32_t window_ms;
+    uint32_t up_milli_per_s;
+    uint32_t down_milli_per_s;
+    uint8_t calm_windows;
+    uint32_t hold_ms;
+    uint32_t min_change_ms;     /**< minimum time between two changes, up or down */
+    uint32_t max_changes;       /**< changes allowed since init, 0 for no limit */
+}MLXRateConfig_s;
+
+typedef struct{
+    MLXRateConfig_s cfg;
+    mlx90632_meas_t rate;       /**< rate requested by the last update */
+    bool primed;                /**< ref_object holds the start of the window */
+    double ref_object;
+    uint32_t ref_ms;
+    uint32_t changed_ms;        /**< time of the last change */
+    uint8_t calm;               /**< calm windows in a row */
+    uint32_t slope_milli;       /**< slope of the last window, in mdegC/s */
+    uint32_t ups;
+    uint32_t downs;
+    uint32_t blocked;           /**< changes held back by min_change_ms or max_changes */
+    uint32_t syncs;             /**< failed changes given back by mlx90632_rate_sync() */
+}MLXRate_s;
+
+typedef struct{
+    mlx90632_meas_t rate;
+    uint32_t slope_milli;       /**< slope of the last window, in mdegC/s */
+    uint32_t ups;               /**< jumps to max_rate */
+    uint32_t downs;             /**< steps down */
+    uint32_t blocked;           /**< changes held back by min_change_ms or max_changes */
+    uint32_t syncs;             /**< failed changes given back by mlx90632_rate_sync() */
+}MLXRateStats_s;
+
+/**
+ * @brief Set the configuration and the current rate
+ *
+ * @param rc controller
+ * @param cfg configuration, NULL for the MLX90632_RATE_* defaults between MLX90632_MEAS_HZ_HALF
+ *            and MLX90632_MEAS_HZ_8
+ * @param rate rate in use (MLX_STS.refresh)
+ *
+ * @return void
+ */
+void mlx90632_rate_init(MLXRate_s *rc, const MLXRateConfig_s *cfg, mlx90632_meas_t rate);
+
+/**
+ * @brief Feed one object temperature and get the rate to use
+ *
+ * @param rc controller
+ * @param object object temperature in degC
+ * @param now_ms time of the sample in ms
+ *
+ * @return mlx90632_meas_t rate to use, the caller writes it only when it changed
+ */
+mlx90632_meas_t mlx90632_rate_update(MLXRate_s *rc, double object, uint32_t now_ms);
+
+/**
+ * @brief Set back the rate in use after the caller failed to apply a change
+ *
+ * The change still counts against max_changes and restarts min_change_ms, as the EEPROM may
+ * have been written in part. The rate is taken as is, also outside min_rate..max_rate, so the
+ * controller does not ask again for the rate that just failed.
+ *
+ * @param rc controller
+ * @param rate rate in use (MLX_STS.refresh)
+ * @param now_ms current time in ms
+ *
+ * @return void
+ */
+void mlx90632_rate_sync(MLXRate_s *rc, mlx90632_meas_t rate, uint32_t now_ms);
+
+/**
+ * @brief Get the current rate, the number of changes and the last slope
+ *
+ * @param rc controller
+ * @param stats pointer to the statistics to fill
+ *
+ * @return void
+ */
+void mlx90632_rate_get_stats(const MLXRate_s *rc, MLXRateStats_s *stats);
+
+#endif /* __MLX90632_RATE_H__ */
@@ -0,0 +1,110 @@
+/******************************************************************************
+ * Copyright (c) 2025 Marconatale Parise.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * You may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************/
+/**
+ * @file mlx90632_ring.h
+ * @brief this file contain a lock-free single-producer/single-consumer ring of raw melexis samples
+ *
+ * Only one thread may call mlx90632_ring_put() and only one thread may call mlx90632_ring_get().
+ * Head is written only by the producer and tail only by the consumer, so no lock is needed.
+ * When the ring is full the new sample is dropped and counted as overrun.
+ *
+ * The following functions will be implemented:
+ * - mlx90632_ring_init() to reset ring indexes and statistics
+ * - mlx90632_ring_put() to push a sample (producer side)
+ * - mlx90632_ring_get() to pop a sample (consumer side)
+ * - mlx90632_ring_get_stats() to get fill level, overruns and high-water mark
+ * 
+ * @author Marconatale Parise
+ * @date 09 June 2025
+ *
+ */
+
+#ifndef __MLX90632_RING_H__
+#define __MLX90632_RING_H__
+
+#include "mlx90632_port.h"
+#include "mlx90632.h"
+
+#define MLX90632_RING_SIZE 32 /**< Number of samples in ring, must be a power of two */
+#define MLX90632_RING_MASK (MLX90632_RING_SIZE - 1)
+
+typedef struct{
+    MLXTempRaw_s raw;
+    uint32_t timestamp_us;
+    uint8_t cycle_pos;
+}MLXSample_s;
+
+typedef struct{
+    MLXSample_s buf[MLX90632_RING_SIZE];
+    atomic_t head;          /**< next slot to write, producer only */
+    atomic_t tail;          /**< next slot to read, consumer only */
+    atomic_t overruns;      /**< samples dropped because ring was full */
+    atomic_t high_water;    /**< maximum fill level reached */
+}MLXRing_s;
+
+typedef struct{
+    uint32_t count;
+    uint32_t overruns;
+    uint32_t high_water;
+}MLXRingStats_s;
+
+/**
+ * @brief Initialize ring
+ *
+ * Reset indexes and statistics. Must be called before producer and consumer start.
+ *
+ * @param ring pointer to the ring
+ *
+ * @return void
+ */
+void mlx90632_ring_init(MLXRing_s *ring);
+
+/**
+ * @brief Push a sample in the ring
+ *
+ * Producer side. If ring is full the sample is dropped and overrun counter is increased.
+ *
+ * @param ring pointer to the ring
+ * @param sample pointer to the sample to copy in the ring
+ *
+ * @return bool true if sample was stored, false if ring was full
+ */
+bool mlx90632_ring_put(MLXRing_s *ring, const MLXSample_s *sample);
+
+/**
+ * @brief Pop a sample from the ring
+ *
+ * Consumer side.
+ *
+ * @param ring pointer to the ring
+ * @param sample pointer where the oldest sample is copied
+ *
+ * @return bool true if a sample was read, false if ring was empty
+ */
+bool mlx90632_ring_get(MLXRing_s *ring, MLXSample_s *sample);
+
+/**
+ * @brief Get ring statistics
+ *
+ * @param ring pointer to the ring
+ * @param stats pointer to the struct to fill with fill level, overruns and high-water mark
+ *
+ * @return void
+ */
+void mlx90632_ring_get_stats(MLXRing_s *ring, MLXRingStats_s *stats);
+
+#endif /* __MLX90632_RING_H__ */
@@ -0,0 +1,120 @@
+/******************************************************************************
+ * Copyright (c) 2025 Marconatale Parise.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * You may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************/
+/**
+ * @file mlx90632_rolling.h
+ * @brief this file contain the rolling statistics of ambient and object temperature
+ *
+ * Each window of span_ms is split in MLX90632_ROLLING_BUCKETS buckets of span_ms / buckets.
+ * A bucket keeps count, min, max, mean and sum of squared deviations of its samples (Welford),
+ * so a sample costs one update of the current bucket of every window, and a query merges the
+ * buckets (Chan et al. pairwise formula) without any sample stored. Memory is constant per
+ * window, whatever the sample rate and the span.
+ *
+ * The window slides by one bucket at a time: a query covers the current bucket and the
+ * MLX90632_ROLLING_BUCKETS - 1 before it, i.e. between span_ms * (buckets - 1) / buckets and
+ * span_ms of samples. Buckets older than that are cleared when time moves on, also across gaps
+ * without samples.
+ *
+ * Times are ms on uint32_t (k_uptime_get_32()), differences are wrap safe.
+ *
+ * The following functions will be implemented:
+ * - mlx90632_rolling_init() to set the window spans
+ * - mlx90632_rolling_add() to add one ambient and object pair
+ * - mlx90632_rolling_get() to get min, max, mean and variance of one window
+ *
+ */
+
+#ifndef __MLX90632_ROLLING_H__
+#define __MLX90632_ROLLING_H__
+
+#include "mlx90632.h"
+
+#define MLX90632_ROLLING_BUCKETS     10 /**< Buckets per window */
+#define MLX90632_ROLLING_MAX_WINDOWS 3  /**< Windows per MLXRolling_s */
+
+typedef struct{
+    uint32_t count;
+    float min;
+    float max;
+    double mean;
+    double m2;                  /**< sum of squared deviations from the mean */
+}MLXRollingAgg_s;
+
+typedef struct{
+    MLXRollingAgg_s ambient;
+    MLXRollingAgg_s object;
+}MLXRollingBucket_s;
+
+typedef struct{
+    uint32_t span_ms;
+    uint32_t bucket_ms;
+    uint32_t start_ms;          /**< start of the current bucket */
+    uint8_t current;
+    MLXRollingBucket_s bucket[MLX90632_ROLLING_BUCKETS];
+}MLXRollingWindow_s;
+
+typedef struct{
+    MLXRollingWindow_s window[MLX90632_ROLLING_MAX_WINDOWS];
+    uint8_t count;
+}MLXRolling_s;
+
+typedef struct{
+    uint32_t count;             /**< samples in the window, other fields are 0 without samples */
+    double min;
+    double max;
+    double mean;
+    double variance;            /**< sample variance, 0 with less than two samples */
+}MLXRollingSummary_s;
+
+/**
+ * @brief Set the window spans and start every window empty
+ *
+ * @param rolling statistics of one sensor
+ * @param spans_ms span of each window in ms, at least MLX90632_ROLLING_BUCKETS
+ * @param count number of windows, limited to MLX90632_ROLLING_MAX_WINDOWS
+ * @param now_ms current time in ms
+ *
+ * @return int 0 on success, -EINVAL on a span shorter than MLX90632_ROLLING_BUCKETS ms
+ */
+int mlx90632_rolling_init(MLXRolling_s *rolling, const uint32_t *spans_ms, uint8_t count, uint32_t now_ms);
+
+/**
+ * @brief Add one ambient and object pair to every window
+ *
+ * @param rolling statistics of one sensor
+ * @param temp temperatures of the sample
+ * @param now_ms time of the sample in ms, not older than the previous one
+ *
+ * @return void
+ */
+void mlx90632_rolling_add(MLXRolling_s *rolling, const MLXTemp_s *temp, uint32_t now_ms);
+
+/**
+ * @brief Get min, max, mean and variance of one window
+ *
+ * @param rolling statistics of one sensor
+ * @param index window index, in the order of the spans given to mlx90632_rolling_init()
+ * @param now_ms current time in ms, buckets older than the span are dropped first
+ * @param ambient pointer to the ambient summary to fill, may be NULL
+ * @param object pointer to the object summary to fill, may be NULL
+ *
+ * @return int 0 on success, -EINVAL on a bad window index
+ */
+int mlx90632_rolling_get(MLXRolling_s *rolling, uint8_t index, uint32_t now_ms,
+                         MLXRollingSummary_s *ambient, MLXRollingSummary_s *object);
+
+#endif /* __MLX90632_ROLLING_H__ */
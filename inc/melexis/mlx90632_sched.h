@@ -0,0 +1,138 @@
+/******************************************************************************
+ * Copyright (c) 2025 Marconatale Parise.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * You may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************/
+/**
+ * @file mlx90632_sched.h
+ * @brief this file contain the scheduler that interleaves conversions of several melexis sensors
+ *
+ * Reading N sensors one after the other costs the sum of their conversion times. The scheduler
+ * starts a conversion (SOC) on every sensor, then sleeps until the sensor expected to finish
+ * first, reads it, restarts it and moves to the next one, so conversions run in parallel and
+ * the bus is used only for status and RAM reads.
+ *
+ * Each sensor has a due time (start + conversion time - wake up margin, as in
+ * mlx90632_start_measurement()). A sensor not ready at its due time is polled again every
+ * conversion time / MLX90632_POLL_INTERVAL_DIV; after MLX90632_SCHED_TIMEOUT_CONV conversion
+ * times without data it is counted as timeout and restarted.
+ *
+ * The following functions will be implemented:
+ * - mlx90632_sched_init() to set the sensors and the sample callback
+ * - mlx90632_sched_step() to service the next sensor due (blocking until it is due)
+ * - mlx90632_sched_get_stats() to get aggregate samples/s and per-sensor staleness
+ * - mlx90632_sched_reset_stats() to reset the statistics
+ *
+ */
+
+#ifndef __MLX90632_SCHED_H__
+#define __MLX90632_SCHED_H__
+
+#include "mlx90632_port.h"
+#include "mlx90632_sensor.h"
+
+#define MLX90632_SCHED_MAX_SENSORS  8 /**< Maximum number of sensors of one scheduler */
+#define MLX90632_SCHED_TIMEOUT_CONV 3 /**< Conversion times without data before a restart */
+
+/**
+ * @brief Sample callback, the sample is read with sensor_channel_get()
+ *
+ * @param dev sensor device with a new sample
+ * @param user user pointer given to mlx90632_sched_init()
+ */
+typedef void (*MLXSchedCallback_t)(const struct device *dev, void *user);
+
+typedef struct{
+    const struct device *dev;
+    uint64_t start_us;          /**< last SOC */
+    uint64_t due_us;            /**< next status check */
+    uint64_t last_sample_us;    /**< last sample read, 0 before the first one */
+    uint32_t conv_time_us;
+    uint32_t samples;
+    uint32_t polls;             /**< status checks, samples included */
+    uint32_t timeouts;
+    uint32_t errors;
+    uint32_t max_gap_us;        /**< longest time between two samples */
+    bool started;
+}MLXSchedSensor_s;
+
+typedef struct{
+    MLXSchedSensor_s sensor[MLX90632_SCHED_MAX_SENSORS];
+    uint8_t count;
+    uint64_t t0_us;             /**< statistics start */
+    MLXSchedCallback_t callback;
+    void *user;
+}MLXSched_s;
+
+typedef struct{
+    uint32_t samples;           /**< samples of all sensors */
+    uint32_t samples_per_sec_milli; /**< aggregate rate since the statistics start, in 1/1000 samples/s */
+    uint32_t elapsed_ms;        /**< time since the statistics start */
+    struct {
+        uint32_t samples;
+        uint32_t polls;
+        uint32_t timeouts;
+        uint32_t errors;
+        uint32_t staleness_us;  /**< age of the last sample now, UINT32_MAX before the first one */
+        uint32_t max_gap_us;    /**< longest time between two samples */
+    } sensor[MLX90632_SCHED_MAX_SENSORS];
+    uint8_t count;
+}MLXSchedStats_s;
+
+/**
+ * @brief Set the sensors and the sample callback
+ *
+ * @param sched scheduler
+ * @param devs array of sensor devices, all must be ready
+ * @param count number of sensors, up to MLX90632_SCHED_MAX_SENSORS
+ * @param callback called from mlx90632_sched_step() for every new sample
+ * @param user user pointer passed to callback
+ *
+ * @return int 0 on success, -EINVAL on bad count, -ENODEV if a device is not ready
+ */
+int mlx90632_sched_init(MLXSched_s *sched, const struct device *const *devs, uint8_t count,
+                        MLXSchedCallback_t callback, void *user);
+
+/**
+ * @brief Service the next sensor due
+ *
+ * Sensors not started yet are started first. Then the call sleeps until the earliest due
+ * time, checks that sensor and, with a new sample, calls the callback and restarts it.
+ *
+ * @param sched scheduler
+ *
+ * @return int 1 if a sample was delivered, 0 if not ready yet, negative error code of the sensor
+ */
+int mlx90632_sched_step(MLXSched_s *sched);
+
+/**
+ * @brief Get aggregate samples/s and per-sensor staleness
+ *
+ * @param sched scheduler
+ * @param stats pointer to the statistics to fill
+ *
+ * @return void
+ */
+void mlx90632_sched_get_stats(const MLXSched_s *sched, MLXSchedStats_s *stats);
+
+/**
+ * @brief Reset the statistics
+ *
+ * @param sched scheduler
+ *
+ * @return void
+ */
+void mlx90632_sched_reset_stats(MLXSched_s *sched);
+
+#endif /* __MLX90632_SCHED_H__ */
@@ -0,0 +1,112 @@
+/******************************************************************************
+ * Copyright (c) 2025 Marconatale Parise.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * You may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************/
+/**
+ * @file mlx90632_sensor.h
+ * @brief this file contain the extensions of the Zephyr sensor API for the melexis driver
+ *
+ * Every okay node with compatible "melexis,mlx90632" is a sensor device with its own bus,
+ * address, calibration, prepared constants and solver state (mlx90632_sensor.c).
+ *
+ * Channels:
+ * - SENSOR_CHAN_AMBIENT_TEMP and SENSOR_CHAN_DIE_TEMP: sensor (ambient) temperature
+ * - SENSOR_CHAN_MLX90632_OBJECT_TEMP: object temperature
+ *
+ * sensor_sample_fetch() starts a measurement in sleeping step mode and waits for it.
+ * With a SENSOR_TRIG_DATA_READY handler installed the sensor runs in continuous mode, a timer
+ * checks the status every half conversion time and the handler is called every time data ready
+ * is set; the RAM bank of the cycle position is read, then data ready is cleared.
+ * sensor_sample_fetch() from the handler returns the sample already read.
+ *
+ * A caller driving several sensors can split a measurement with mlx90632_sensor_start() and
+ * mlx90632_sensor_poll() (see mlx90632_sched.h), then read the sample with sensor_channel_get().
+ * mlx90632_read_async() runs a whole measurement (clear, SOC, status, RAM read, compute) on the
+ * system work queue with callback i2c transfers and calls back on completion, so one thread can
+ * start all sensors and none blocks on the bus.
+ *
+ * Emissivity is set from devicetree (emissivity-milli) or at runtime with
+ * SENSOR_ATTR_MLX90632_EMISSIVITY (0 < emissivity <= 1).
+ *
+ */
+
+#ifndef __MLX90632_SENSOR_H__
+#define __MLX90632_SENSOR_H__
+
+#include <zephyr/drivers/sensor.h>
+
+#define MLX90632_SENSOR_POLL_DIV 2 /**< Status checks per conversion time in trigger mode */
+
+enum sensor_channel_mlx90632 {
+    SENSOR_CHAN_MLX90632_OBJECT_TEMP = SENSOR_CHAN_PRIV_START,
+};
+
+enum sensor_attribute_mlx90632 {
+    SENSOR_ATTR_MLX90632_EMISSIVITY = SENSOR_ATTR_PRIV_START,
+};
+
+/**
+ * @brief Completion callback of mlx90632_read_async(), called from the system work queue
+ *
+ * @param dev sensor device
+ * @param result 0 with a new sample available to sensor_channel_get(), negative error code otherwise
+ * @param user user pointer given to mlx90632_read_async()
+ */
+typedef void (*MLXAsyncCallback_t)(const struct device *dev, int result, void *user);
+
+/**
+ * @brief Start a conversion in sleeping step mode without waiting for it
+ *
+ * @param dev sensor device
+ *
+ * @return int 0 on success, -EBUSY with a data ready trigger installed, or a bus error code
+ */
+int mlx90632_sensor_start(const struct device *dev);
+
+/**
+ * @brief Check data ready once and read and convert the sample if set
+ *
+ * @param dev sensor device
+ *
+ * @return int 1 if a new sample is available to sensor_channel_get(), 0 if the conversion
+ * is not complete, -EBUSY with a data ready trigger installed, or a negative error code
+ */
+int mlx90632_sensor_poll(const struct device *dev);
+
+/**
+ * @brief Get the conversion time of one cycle position
+ *
+ * @param dev sensor device
+ *
+ * @return uint32_t conversion time in us, from the refresh rate in eeprom
+ */
+uint32_t mlx90632_sensor_conv_time_us(const struct device *dev);
+
+/**
+ * @brief Start an asynchronous measurement in sleeping step mode
+ *
+ * Returns immediately. Data ready clear, SOC, status polls and the RAM burst read are chained
+ * i2c transfers, the conversion is computed on the system work queue and cb is called with
+ * the result. Until then the blocking API of the device returns -EBUSY.
+ *
+ * @param dev sensor device
+ * @param cb completion callback, may be NULL
+ * @param user user pointer passed to cb
+ *
+ * @return int 0 if started, -EBUSY with a measurement in progress or a data ready trigger installed
+ */
+int mlx90632_read_async(const struct device *dev, MLXAsyncCallback_t cb, void *user);
+
+#endif /* __MLX90632_SENSOR_H__ */
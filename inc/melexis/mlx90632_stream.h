@@ -0,0 +1,151 @@
+/******************************************************************************
+ * Copyright (c) 2025 Marconatale Parise.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * You may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************/
+/**
+ * @file mlx90632_stream.h
+ * @brief this file contain the binary frame format of the melexis sample stream
+ *
+ * One sample is one fixed-size frame of MLX90632_STREAM_FRAME_LEN bytes, little endian,
+ * against ~80 bytes of text per sample:
+ *
+ * | offset | size | field                                                   |
+ * |--------|------|---------------------------------------------------------|
+ * | 0      | 2    | sync 0xA5 0x5A                                          |
+ * | 2      | 1    | format version (MLX90632_STREAM_VERSION)                |
+ * | 3      | 1    | sensor id                                               |
+ * | 4      | 2    | sequence number, +1 per frame, wraps                    |
+ * | 6      | 1    | cycle position, 0 if unknown                            |
+ * | 7      | 1    | flags (MLX90632_STREAM_FLAG_RAW, MLX90632_STREAM_FLAG_TEMP) |
+ * | 8      | 4    | timestamp in us                                         |
+ * | 12     | 8    | raw ambient_ram_6, ambient_ram_9, object_ram_4_7, object_ram_5_8 |
+ * | 20     | 2    | ambient temperature in 0.01 degC                        |
+ * | 22     | 2    | object temperature in 0.01 degC                         |
+ * | 24     | 2    | CRC-16/CCITT-FALSE of bytes 2 to 23                     |
+ *
+ * Temperatures saturate at the int16 range (-327.68 to 327.67 degC). Fields not flagged
+ * are 0. The decoder resynchronizes on the sync word and checks the CRC, so frames can share
+ * a uart with console text.
+ *
+ * The file is plain C and compiles on the host too (host/mlx90632_stream_decode.c).
+ *
+ * The following functions will be implemented:
+ * - mlx90632_stream_crc16() to compute the frame CRC
+ * - mlx90632_stream_centi() to convert a temperature to 0.01 degC
+ * - mlx90632_stream_encode() to build a frame from a record
+ * - mlx90632_stream_decode() to check a frame and read its record
+ * - mlx90632_stream_decoder_init() and mlx90632_stream_feed() to decode a byte stream
+ *
+ */
+
+#ifndef __MLX90632_STREAM_H__
+#define __MLX90632_STREAM_H__
+
+#include <stdint.h>
+#include <stddef.h>
+#include "mlx90632.h"
+
+#define MLX90632_STREAM_FRAME_LEN   26
+#define MLX90632_STREAM_SYNC0       0xA5
+#define MLX90632_STREAM_SYNC1       0x5A
+#define MLX90632_STREAM_VERSION     1
+
+#define MLX90632_STREAM_FLAG_RAW    BIT(0) /**< raw fields are valid */
+#define MLX90632_STREAM_FLAG_TEMP   BIT(1) /**< temperature fields are valid */
+
+typedef struct{
+    uint32_t timestamp_us;
+    uint16_t seq;
+    uint8_t sensor_id;
+    uint8_t cycle_pos;
+    uint8_t flags;
+    MLXTempRaw_s raw;
+    int16_t ambient_centi;
+    int16_t object_centi;
+}MLXStreamRecord_s;
+
+typedef struct{
+    uint8_t buf[MLX90632_STREAM_FRAME_LEN];
+    uint8_t len;                /**< bytes of the frame being received */
+    bool synced;                /**< a valid frame was received, next_seq is meaningful */
+    uint16_t next_seq;
+    uint32_t frames;            /**< valid frames */
+    uint32_t crc_errors;        /**< frames with sync but bad CRC or version */
+    uint32_t lost;              /**< frames missing according to the sequence number */
+    uint32_t skipped;           /**< bytes discarded while searching the sync word */
+}MLXStreamDecoder_s;
+
+/**
+ * @brief Compute the CRC-16/CCITT-FALSE (poly 0x1021, init 0xFFFF) of a buffer
+ *
+ * @param buf data
+ * @param len number of bytes
+ *
+ * @return uint16_t crc
+ */
+uint16_t mlx90632_stream_crc16(const uint8_t *buf, size_t len);
+
+/**
+ * @brief Convert a temperature to 0.01 degC, rounded and saturated to int16
+ *
+ * @param temp temperature in degC
+ *
+ * @return int16_t temperature in 0.01 degC
+ */
+int16_t mlx90632_stream_centi(double temp);
+
+/**
+ * @brief Build a frame from a record
+ *
+ * @param rec record to send
+ * @param frame buffer of MLX90632_STREAM_FRAME_LEN bytes
+ *
+ * @return void
+ */
+void mlx90632_stream_encode(const MLXStreamRecord_s *rec, uint8_t *frame);
+
+/**
+ * @brief Check a frame and read its record
+ *
+ * @param frame MLX90632_STREAM_FRAME_LEN bytes
+ * @param rec pointer to the record to fill
+ *
+ * @return int 0 on success, -EBADMSG on bad sync, version or CRC
+ */
+int mlx90632_stream_decode(const uint8_t *frame, MLXStreamRecord_s *rec);
+
+/**
+ * @brief Reset a stream decoder
+ *
+ * @param dec decoder
+ *
+ * @return void
+ */
+void mlx90632_stream_decoder_init(MLXStreamDecoder_s *dec);
+
+/**
+ * @brief Feed one received byte to a stream decoder
+ *
+ * On a bad frame the decoder searches the next sync word inside the bytes already received.
+ *
+ * @param dec decoder
+ * @param byte received byte
+ * @param rec pointer to the record filled when a frame completes
+ *
+ * @return int 1 if rec holds a new valid record, 0 otherwise
+ */
+int mlx90632_stream_feed(MLXStreamDecoder_s *dec, uint8_t byte, MLXStreamRecord_s *rec);
+
+#endif /* __MLX90632_STREAM_H__ */
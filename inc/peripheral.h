@@ -13,6 +13,8 @@
  *
  * The following functions will be implemented:
  * - peripheral_init() to initialize the peripherals
+ * - peripheral_post_event() to wake the thread waiting for peripheral events
+ * - peripheral_wait_event() to sleep until at least one peripheral event is posted
  * - reset_interrupt_ob1203() to reset the OB1203 interrupt status
  * - get_status_interrupt_ob1203() to get the OB1203 interrupt status
  * 
@@ -31,6 +33,13 @@
 #include "mlx90632.h"
 #include "i2c_comm.h"
 
+#define PERIPHERAL_EVT_BTN1     BIT(BTN1_ch)        //button 1 edge, posted from the gpio interrupt
+#define PERIPHERAL_EVT_BTN2     BIT(BTN2_ch)        //button 2 edge, posted from the gpio interrupt
+#define PERIPHERAL_EVT_SHUTDOWN BIT(NUM_GPIO_PERIP) //stop acquisition and leave the main loop, posted by a long press of button 2
+#define PERIPHERAL_EVT_USER     BIT(8)              //first bit free for application events (timers)
+
+#define PERIPHERAL_LONG_PRESS   3000 //ms button 2 is held down to post PERIPHERAL_EVT_SHUTDOWN
+
 
 /**
  * @brief Initialize peripherals
@@ -65,4 +74,28 @@ bool is_button1_pressed();
  */
 bool is_button2_pressed();
 
+/**
+ * @brief Post peripheral events
+ *
+ * Set the event bits and wake the thread blocked in peripheral_wait_event(). Bits posted again
+ * before they are consumed are merged. Safe from interrupts and timer expiry functions.
+ *
+ * @param events bitmask of PERIPHERAL_EVT_* bits
+ *
+ * @return void
+ */
+void peripheral_post_event(uint32_t events);
+
+/**
+ * @brief Wait for peripheral events
+ *
+ * Block until at least one event is posted or timeout expires, then return and clear every
+ * pending bit. Only one thread must wait.
+ *
+ * @param timeout maximum time to wait, K_FOREVER to wait for an event
+ *
+ * @return uint32_t bitmask of the posted events, 0 on timeout
+ */
+uint32_t peripheral_wait_event(k_timeout_t timeout);
+
 #endif /* __PERIPHERAL_H__ */
\ No newline at end of file
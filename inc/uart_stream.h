@@ -0,0 +1,76 @@
+/******************************************************************************
+ * Copyright (c) 2025 Marconatale Parise.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * You may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************/
+/**
+ * @file uart_stream.h
+ * @brief this file contain the uart transport of the binary sample stream (mlx90632_stream.h)
+ *
+ * Frames are sent on the uart of the devicetree alias mlx-stream with the async uart API, so
+ * the uarte EasyDMA moves the bytes and the caller only copies a frame into a buffer.
+ * Two buffers of UART_STREAM_BUF_FRAMES frames alternate: one is transmitted while the other
+ * is filled, a frame that does not fit is dropped and counted (the decoder sees the missing
+ * sequence number). Without async API support on the uart, frames are sent with
+ * uart_poll_out().
+ *
+ * The following functions will be implemented:
+ * - uart_stream_init() to get the uart and set the tx callback
+ * - uart_stream_send() to number, encode and queue one record
+ * - uart_stream_get_stats() to get sent, dropped and failed frames
+ *
+ */
+
+#ifndef __UART_STREAM_H__
+#define __UART_STREAM_H__
+
+#include "common.h"
+#include "mlx90632_stream.h"
+
+#define UART_STREAM_BUF_FRAMES  8 //frames per tx buffer, two buffers
+
+typedef struct{
+    uint32_t frames;    //frames queued
+    uint32_t dropped;   //frames dropped with both buffers busy
+    uint32_t errors;    //tx that failed to start or aborted
+}UartStreamStats_s;
+
+/**
+ * @brief Get the stream uart and set the tx callback
+ *
+ * @return int 0 on success, -ENODEV without mlx-stream alias or uart not ready
+ */
+int uart_stream_init(void);
+
+/**
+ * @brief Number, encode and queue one record
+ *
+ * The sequence number of rec is overwritten with the stream sequence number.
+ *
+ * @param rec record to send
+ *
+ * @return int 0 if queued, -ENOMEM if dropped, -ENODEV if the stream is not initialized
+ */
+int uart_stream_send(MLXStreamRecord_s *rec);
+
+/**
+ * @brief Get sent, dropped and failed frames
+ *
+ * @param stats pointer to the statistics to fill
+ *
+ * @return void
+ */
+void uart_stream_get_stats(UartStreamStats_s *stats);
+
+#endif /* __UART_STREAM_H__ */
@@ -0,0 +1,395 @@
+/******************************************************************************
+ *
+ * Copyright (c) 2025 Marconatale Parise. All rights reserved.
+ *
+ * This file is part of proprietary software. Unauthorized copying, distribution,
+ * or modification of this file, via any medium, is strictly prohibited without
+ * prior written permission from the copyright holder.
+ *
+ *****************************************************************************/
+/**
+ * @file acquisition.c
+ * @brief melexis acquisition and processing threads
+ *
+ * This implementation file provides the acquisition thread, that reads raw samples from the
+ * sensor, and the processing thread, that converts and publishes temperatures.
+ * 
+ * @author Marconatale Parise
+ * @date 09 June 2025
+ *
+ */
+#include "acquisition.h"
+
+LOG_MODULE_DECLARE(app, CONFIG_APP_LOG_LEVEL);
+
+static MLXRing_s acq_ring;
+static atomic_t acq_enabled;
+static atomic_t acq_rate_req = ATOMIC_INIT(MLX90632_MEAS_HZ_ERROR); //refresh rate asked by the processing thread
+static atomic_t acq_rate_sync = ATOMIC_INIT(MLX90632_MEAS_HZ_ERROR); //refresh rate in use after a failed change
+static atomic_t acq_rate_fault; //measurement table in EEPROM not restored after a failed change
+static MLXRate_s proc_rate;
+
+static const MLXFilterConfig_s acq_filter_cfg = {
+    .type = (mlx90632_filter_t)MLX_FILTER,
+    .ema_alpha = MLX90632_FILTER_EMA_ALPHA,
+    .median_len = MLX90632_FILTER_MEDIAN_LEN,
+    .kalman_q = MLX90632_FILTER_KALMAN_Q,
+    .kalman_r = MLX90632_FILTER_KALMAN_R,
+};
+
+static const uint32_t acq_rolling_spans[] = ACQ_ROLLING_SPANS;
+
+K_SEM_DEFINE(acq_start_sem, 0, 1);
+K_SEM_DEFINE(acq_data_sem, 0, K_SEM_MAX_LIMIT);
+K_SEM_DEFINE(acq_tick_sem, 0, 1);
+
+static void acquisition_tick(struct k_timer *timer){
+    k_sem_give(&acq_tick_sem);
+}
+
+K_TIMER_DEFINE(acq_timer, acquisition_tick, NULL);
+
+void acquisition_start(void){
+    if (!atomic_set(&acq_enabled, 1))
+        k_sem_give(&acq_start_sem);
+}
+
+void acquisition_stop(void){
+    atomic_set(&acq_enabled, 0);
+    k_sem_give(&acq_tick_sem); //do not wait for the next tick to stop
+}
+
+void acquisition_get_ring_stats(MLXRingStats_s *stats){
+    mlx90632_ring_get_stats(&acq_ring, stats);
+}
+
+/* The EEPROM is written from the thread that owns the bus, between two samples */
+static void acquisition_apply_rate(void){
+    mlx90632_meas_t rate = (mlx90632_meas_t)atomic_set(&acq_rate_req, MLX90632_MEAS_HZ_ERROR);
+    int32_t ret;
+
+    if ((rate == MLX90632_MEAS_HZ_ERROR) || (rate == (mlx90632_meas_t)MLX_STS.refresh) || atomic_get(&acq_rate_fault))
+        return;
+
+    ret = mlx90632_set_refresh_rate(rate);
+    if (ret == -EFAULT){
+        //the sensor runs the table of the last reset, the next reset loads a broken one: no more writes
+        LOG("Error: refresh rate %d not set and measurement table in EEPROM not restored, rate changes stopped", rate);
+        atomic_set(&acq_rate_fault, 1);
+    } else if (ret < 0){
+        //the controller goes back to the rate the sensor still uses
+        LOG("Refresh rate %d not set, %d kept", rate, MLX_STS.refresh);
+        atomic_set(&acq_rate_sync, MLX_STS.refresh);
+    }
+}
+
+/* Extended range table in sleeping step mode is measured with one SOB, whatever MLX_BURST.
+ * In continuous mode (MLX90632_MTYP_EXTENDED) it goes through mlx90632_wait_continuous() */
+static bool acquisition_extended(void){
+    return MLX_STS.meas_type == MLX90632_MTYP_EXTENDED_BURST;
+}
+
+/* With ACQ_SAMPLE_PERIOD each measurement starts on a tick of the timer, unless the sensor runs
+ * continuous or the adaptive rate controller sets the pace */
+static bool acquisition_paced(void){
+    return ACQ_SAMPLE_PERIOD && !MLX_CONTINUOUS && !MLX_ADAPTIVE_RATE;
+}
+
+/* One SOB per table: every record of the batch goes to the ring, timestamped at its own position */
+static int acquisition_burst(void){
+    MLXBurst_s burst;
+    MLXSample_s sample;
+    uint32_t now;
+    int count, i;
+
+    count = mlx90632_read_burst(&burst);
+    mlx90632_checkTimeout(count);
+    if (count < 0)
+        return count;
+
+    now = k_ticks_to_us_floor32(k_uptime_ticks());
+    for (i = 0; i < count; i++){
+        sample.raw = burst.raw[i];
+        sample.cycle_pos = burst.cycle_pos[i];
+        sample.timestamp_us = now - (uint32_t)(count - 1 - i) * MLX_STS.conv_time_us;
+        mlx90632_ring_put(&acq_ring, &sample);
+    }
+    return count;
+}
+
+static int acquisition_sample(MLXSample_s *sample){
+    int cycle_pos;
+    int32_t ret;
+
+    if (MLX_CONTINUOUS){
+        cycle_pos = mlx90632_wait_continuous();
+        if (cycle_pos < 0)
+            return cycle_pos;
+        sample->raw = MLX_T_RAW;
+    } else {
+        cycle_pos = mlx90632_start_measurement();
+        mlx90632_checkTimeout(cycle_pos);
+        if (cycle_pos < 0)
+            return cycle_pos;
+        ret = mlx90632_readTempRaw(cycle_pos, &sample->raw);
+        if (ret < 0)
+            return ret;
+    }
+
+    sample->timestamp_us = k_ticks_to_us_floor32(k_uptime_ticks());
+    sample->cycle_pos = (uint8_t)cycle_pos;
+    return 0;
+}
+
+/* Summary of each window once per span, in place of the samples printed one by one */
+static void acquisition_rolling_report(MLXRolling_s *rolling, uint32_t *reported, const char *name, uint32_t now){
+    MLXRollingSummary_s ambient, object;
+    uint8_t i;
+
+    for (i = 0; i < rolling->count; i++){
+        if (now - reported[i] < rolling->window[i].span_ms)
+            continue;
+        reported[i] = now;
+        mlx90632_rolling_get(rolling, i, now, &ambient, &object);
+        LOG("%s %u s: %u samples, object min %.4f max %.4f mean %.4f sd %.4f, ambient mean %.4f sd %.4f",
+            name, rolling->window[i].span_ms / 1000, object.count, object.min, object.max, object.mean,
+            sqrt(object.variance), ambient.mean, sqrt(ambient.variance));
+    }
+}
+
+#if MLX_MULTI
+#define ACQ_SENSOR_DEV(node) DEVICE_DT_GET(node),
+
+static const struct device *const acq_sensors[] = {
+    DT_FOREACH_STATUS_OKAY(melexis_mlx90632, ACQ_SENSOR_DEV)
+};
+static MLXSched_s acq_sched;
+static MLXFilter_s acq_filters[ARRAY_SIZE(acq_sensors)];
+static MLXRolling_s acq_rolling[ARRAY_SIZE(acq_sensors)];
+static uint32_t acq_rolling_reported[ARRAY_SIZE(acq_sensors)][MLX90632_ROLLING_MAX_WINDOWS];
+
+static void acquisition_multi_sample(const struct device *dev, void *user){
+    struct sensor_value ambient, object;
+    MLXStreamRecord_s rec = {0};
+    MLXTemp_s temp;
+    uint8_t i;
+
+    sensor_channel_get(dev, SENSOR_CHAN_AMBIENT_TEMP, &ambient);
+    sensor_channel_get(dev, (enum sensor_channel)SENSOR_CHAN_MLX90632_OBJECT_TEMP, &object);
+
+    for (i = 0; (i < ARRAY_SIZE(acq_sensors)) && (acq_sensors[i] != dev); i++);
+    temp.ambient = sensor_value_to_double(&ambient);
+    temp.object = sensor_value_to_double(&object);
+    if (i < ARRAY_SIZE(acq_sensors))
+        mlx90632_filter_apply(&acq_filters[i], &temp);
+    if (MLX_ROLLING && (i < ARRAY_SIZE(acq_sensors))){
+        mlx90632_rolling_add(&acq_rolling[i], &temp, k_uptime_get_32());
+        acquisition_rolling_report(&acq_rolling[i], acq_rolling_reported[i], dev->name, k_uptime_get_32());
+    }
+
+    if (MLX_STREAM){
+        rec.timestamp_us = k_ticks_to_us_floor32(k_uptime_ticks());
+        rec.sensor_id = i;
+        rec.flags = MLX90632_STREAM_FLAG_TEMP;
+        rec.ambient_centi = mlx90632_stream_centi(temp.ambient);
+        rec.object_centi = mlx90632_stream_centi(temp.object);
+        uart_stream_send(&rec);
+    } else if (!MLX_ROLLING){
+        LOG("%s ambient %.4f object %.4f", dev->name, temp.ambient, temp.object);
+    }
+}
+
+static void acquisition_multi_stats(void){
+    MLXSchedStats_s stats;
+    uint8_t i;
+
+    mlx90632_sched_get_stats(&acq_sched, &stats);
+    mlx90632_sched_reset_stats(&acq_sched);
+    LOG("sched: %u samples in %u ms, %u.%03u samples/s", stats.samples, stats.elapsed_ms,
+        stats.samples_per_sec_milli / 1000, stats.samples_per_sec_milli % 1000);
+    for (i = 0; i < stats.count; i++)
+        LOG("sched: %s %u samples, %u polls, %u timeouts, %u errors, staleness %u us, max gap %u us",
+            acq_sensors[i]->name, stats.sensor[i].samples, stats.sensor[i].polls, stats.sensor[i].timeouts,
+            stats.sensor[i].errors, stats.sensor[i].staleness_us, stats.sensor[i].max_gap_us);
+}
+
+static void acquisition_thread(void *p1, void *p2, void *p3){
+    uint32_t stats_time = 0;
+    bool running = false;
+    uint8_t i, j;
+
+    while (1){
+        if (!atomic_get(&acq_enabled)){
+            running = false;
+            k_sem_take(&acq_start_sem, K_FOREVER);
+            continue;
+        }
+
+        if (!running){
+            if (mlx90632_sched_init(&acq_sched, acq_sensors, ARRAY_SIZE(acq_sensors), acquisition_multi_sample, NULL) < 0){
+                msleep(ACQ_ERROR_BACKOFF);
+                continue;
+            }
+            stats_time = k_uptime_get_32();
+            for (i = 0; i < ARRAY_SIZE(acq_filters); i++){
+                mlx90632_filter_init(&acq_filters[i], &acq_filter_cfg);
+                mlx90632_rolling_init(&acq_rolling[i], acq_rolling_spans, ARRAY_SIZE(acq_rolling_spans), stats_time);
+                for (j = 0; j < MLX90632_ROLLING_MAX_WINDOWS; j++)
+                    acq_rolling_reported[i][j] = stats_time;
+            }
+            running = true;
+        }
+
+        mlx90632_sched_step(&acq_sched);
+
+        if (DEBUG && (k_uptime_get_32() - stats_time >= ACQ_SCHED_STATS_PERIOD)){
+            stats_time += ACQ_SCHED_STATS_PERIOD;
+            acquisition_multi_stats();
+        }
+    }
+}
+#else
+static void acquisition_thread(void *p1, void *p2, void *p3){
+    MLXSample_s sample;
+    bool running = false;
+
+    while (1){
+        if (!atomic_get(&acq_enabled)){
+            if (running && MLX_CONTINUOUS)
+                mlx90632_stop_continuous();
+            k_timer_stop(&acq_timer);
+            running = false;
+            k_sem_take(&acq_start_sem, K_FOREVER);
+            continue;
+        }
+
+        if (!running){
+            if (MLX_CONTINUOUS)
+                mlx90632_start_continuous();
+            if (acquisition_paced()){
+                k_sem_reset(&acq_tick_sem);
+                k_timer_start(&acq_timer, K_NO_WAIT, K_MSEC(ACQ_SAMPLE_PERIOD));
+            }
+            running = true;
+        }
+
+        if (acquisition_paced()){
+            k_sem_take(&acq_tick_sem, K_FOREVER);
+            if (!atomic_get(&acq_enabled))
+                continue;
+        }
+
+        if (MLX_ADAPTIVE_RATE)
+            acquisition_apply_rate();
+
+        if ((MLX_BURST && !MLX_CONTINUOUS) || acquisition_extended()){
+            if (acquisition_burst() < 0){
+                msleep(ACQ_ERROR_BACKOFF);
+                continue;
+            }
+            k_sem_give(&acq_data_sem);
+            continue;
+        }
+
+        if (acquisition_sample(&sample) < 0){
+            msleep(ACQ_ERROR_BACKOFF);
+            continue;
+        }
+
+        mlx90632_ring_put(&acq_ring, &sample);
+        k_sem_give(&acq_data_sem);
+    }
+}
+#endif
+
+static void processing_stream(const MLXSample_s *sample, const MLXTemp_s *temp){
+    MLXStreamRecord_s rec = {
+        .timestamp_us = sample->timestamp_us,
+        .cycle_pos = sample->cycle_pos,
+        .flags = MLX90632_STREAM_FLAG_RAW | MLX90632_STREAM_FLAG_TEMP,
+        .raw = sample->raw,
+        .ambient_centi = mlx90632_stream_centi(temp->ambient),
+        .object_centi = mlx90632_stream_centi(temp->object),
+    };
+
+    uart_stream_send(&rec);
+}
+
+/* Ask the acquisition thread for a new refresh rate only when the controller changes it */
+static void processing_rate(const MLXTemp_s *temp){
+    static bool ready;
+    mlx90632_meas_t rate;
+
+    if (atomic_get(&acq_rate_fault))
+        return;
+
+    if (!ready){
+        //refresh rate read failed: MLX90632_MEAS_HZ_ERROR, no controller until the sensor gives a valid one
+        if (MLX_STS.refresh > MLX90632_MEAS_HZ_64)
+            return;
+        mlx90632_rate_init(&proc_rate, NULL, (mlx90632_meas_t)MLX_STS.refresh);
+        if (proc_rate.rate != (mlx90632_meas_t)MLX_STS.refresh)
+            atomic_set(&acq_rate_req, proc_rate.rate);
+        ready = true;
+    }
+
+    rate = (mlx90632_meas_t)atomic_set(&acq_rate_sync, MLX90632_MEAS_HZ_ERROR);
+    if (rate != MLX90632_MEAS_HZ_ERROR)
+        mlx90632_rate_sync(&proc_rate, rate, k_uptime_get_32());
+
+    rate = proc_rate.rate;
+    if (mlx90632_rate_update(&proc_rate, temp->object, k_uptime_get_32()) != rate)
+        atomic_set(&acq_rate_req, proc_rate.rate);
+}
+
+static void processing_thread(void *p1, void *p2, void *p3){
+    static MLXRolling_s rolling;
+    uint32_t reported[MLX90632_ROLLING_MAX_WINDOWS];
+    MLXSample_s sample;
+    MLXRingStats_s stats;
+    MLXFilter_s filter;
+    uint32_t overruns = 0;
+    uint32_t last_us = 0;
+    uint8_t i;
+
+    mlx90632_filter_init(&filter, &acq_filter_cfg);
+    mlx90632_rolling_init(&rolling, acq_rolling_spans, ARRAY_SIZE(acq_rolling_spans), k_uptime_get_32());
+    for (i = 0; i < ARRAY_SIZE(reported); i++)
+        reported[i] = k_uptime_get_32();
+
+    while (1){
+        k_sem_take(&acq_data_sem, K_FOREVER);
+
+        while (mlx90632_ring_get(&acq_ring, &sample)){
+            mlx90632_calc_temp_kernel(&sample.raw, &MLX_T);
+            if (sample.timestamp_us - last_us > ACQ_FILTER_GAP * 1000U)
+                mlx90632_filter_reset(&filter);
+            last_us = sample.timestamp_us;
+            mlx90632_filter_apply(&filter, &MLX_T);
+            if (MLX_ADAPTIVE_RATE)
+                processing_rate(&MLX_T);
+            if (MLX_ROLLING)
+                mlx90632_rolling_add(&rolling, &MLX_T, k_uptime_get_32());
+            if (MLX_STREAM){
+                processing_stream(&sample, &MLX_T);
+                continue;
+            }
+            if (MLX_ROLLING)
+                continue;
+            LOG("Ambient temperature measured value: %.4f", MLX_T.ambient);
+            LOG("Object temperature measured value: %.4f", MLX_T.object);
+        }
+
+        if (MLX_ROLLING)
+            acquisition_rolling_report(&rolling, reported, "mlx90632", k_uptime_get_32());
+
+        mlx90632_ring_get_stats(&acq_ring, &stats);
+        if (stats.overruns != overruns){
+            LOG("Acquisition ring overrun: %u samples dropped, high-water %u/%u", stats.overruns, stats.high_water, MLX90632_RING_SIZE);
+            overruns = stats.overruns;
+        }
+    }
+}
+
+K_THREAD_DEFINE(acq_tid, ACQ_STACK_SIZE, acquisition_thread, NULL, NULL, NULL, ACQ_PRIORITY, 0, 0);
+K_THREAD_DEFINE(proc_tid, PROC_STACK_SIZE, processing_thread, NULL, NULL, NULL, PROC_PRIORITY, 0, 0);
@@ -12,7 +12,7 @@
  * @brief main function to initialize peripherals and handle OB1203 interrupts
  *
  * This file contains the main function that initializes the peripherals and
- * call melexis function for ambient and object temperature reading.
+ * start or stop melexis acquisition thread for ambient and object temperature reading.
  * 
  * @author Marconatale Parise
  * @date 09 June 2025
@@ -21,19 +21,93 @@
 
 #include "peripheral.h"
 #include "mlx90632.h"
+#include "acquisition.h"
+#include "mlx90632_bench.h"
+#ifdef CONFIG_EMUL
+#include "mlx90632_emul.h"
+#endif
 
-bool enable_measure = false;
+LOG_MODULE_REGISTER(app, CONFIG_APP_LOG_LEVEL);
+
+#define EMUL_STATS_PERIOD 10000 //ms between emulator statistics on native_posix
+#define BENCH_ITERATIONS 1000 //timed runs per stage when MLX_BENCH is set
+#define BUS_STATS_PERIOD 60000 //ms between i2c statistics dumps when MLX_BUS_STATS is set
+
+#define APP_EVT_BUS_STATS  PERIPHERAL_EVT_USER        //BUS_STATS_PERIOD elapsed
+#define APP_EVT_EMUL_STATS (PERIPHERAL_EVT_USER << 1) //EMUL_STATS_PERIOD elapsed
+
+/* Periodic timers are rescheduled on absolute ticks: the period does not drift with the work done on expiry */
+static void app_timer_expiry(struct k_timer *timer){
+	peripheral_post_event((uint32_t)(uintptr_t)k_timer_user_data_get(timer));
+}
+
+K_TIMER_DEFINE(bus_stats_timer, app_timer_expiry, NULL);
+
+#ifdef CONFIG_EMUL
+K_TIMER_DEFINE(emul_stats_timer, app_timer_expiry, NULL);
+
+/**
+ * @brief Log throughput, latency and bus traffic measured by the emulated sensor
+ *
+ * @return void
+ */
+static void emul_stats_log(void){
+	const struct emul *target = EMUL_DT_GET(DT_NODELABEL(mlx90632));
+	MLXEmulStats_s stats;
+
+	mlx90632_emul_get_stats(target, &stats);
+	mlx90632_emul_reset_stats(target);
+	LOG("emul: %u samples read of %u, latency min %u max %u mean %u us",
+		stats.samples_read, stats.samples, stats.latency_min_us, stats.latency_max_us,
+		stats.samples_read ? (uint32_t)(stats.latency_total_us / stats.samples_read) : 0);
+	LOG("emul: %u transfers (%u reads, %u status, %u writes), %u words, %u nacks",
+		stats.transfers, stats.reads, stats.status_reads, stats.writes, stats.words_read, stats.nacks);
+}
+#endif
 
 void main(void){
 
 	peripheral_init();
-	
+	if(MLX_STREAM)uart_stream_init();
+
+	if(MLX_BENCH){
+		static MLXBench_s bench;
+
+		mlx90632_bench_run(BENCH_ITERATIONS, &bench);
+		mlx90632_bench_print(&bench);
+	}
+
+	if(MLX_BUS_STATS && DEBUG){
+		k_timer_user_data_set(&bus_stats_timer, (void *)(uintptr_t)APP_EVT_BUS_STATS);
+		k_timer_start(&bus_stats_timer, K_MSEC(BUS_STATS_PERIOD), K_MSEC(BUS_STATS_PERIOD));
+	}
+
+#ifdef CONFIG_EMUL
+	k_timer_user_data_set(&emul_stats_timer, (void *)(uintptr_t)APP_EVT_EMUL_STATS);
+	k_timer_start(&emul_stats_timer, K_MSEC(EMUL_STATS_PERIOD), K_MSEC(EMUL_STATS_PERIOD));
+
+	acquisition_start(); //no buttons to press on native_posix
+#endif
+
+	//the thread sleeps until a button edge, a timer or a shutdown request is posted
 	while (1){
+		uint32_t events = peripheral_wait_event(K_FOREVER);
 
-		if(is_button1_pressed())enable_measure = true;
-		if(is_button2_pressed())enable_measure = false;
-		if(enable_measure) mlx90632_read();
-		msleep(1000);
-	}	
+		if(events & PERIPHERAL_EVT_BTN1)acquisition_start();
+		if(events & PERIPHERAL_EVT_BTN2)acquisition_stop();
+		if(events & APP_EVT_BUS_STATS)mlx90632_i2c_dump_stats();
+#ifdef CONFIG_EMUL
+		if(events & APP_EVT_EMUL_STATS)emul_stats_log();
+#endif
+		if(events & PERIPHERAL_EVT_SHUTDOWN){
+			acquisition_stop();
+			k_timer_stop(&bus_stats_timer);
+#ifdef CONFIG_EMUL
+			k_timer_stop(&emul_stats_timer);
+#endif
+			LOG("Shutdown requested, main loop stopped");
+			break;
+		}
+	}
 
 }
\ No newline at end of file
@@ -27,6 +27,11 @@
  *
  */
 #include "mlx90632.h"
+#include "mlx90632_cache.h"
+#include "mlx90632_kernel.h"
+#include <stddef.h>
+
+LOG_MODULE_REGISTER(mlx90632, CONFIG_MLX90632_LOG_LEVEL);
 
 
 
@@ -44,11 +49,47 @@ static const char mlx90632version[] __attribute__((used)) = { VERSION };
 MLXCalib_s MLX_K = {0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 };
 MLXTempRaw_s MLX_T_RAW = {.ambient_ram_6 = 0, .ambient_ram_9 = 0, .object_ram_4_7 = 0, .object_ram_5_8 = 0};
 MLXTemp_s MLX_T = {.ambient = 0.0, .object = 0.0};
-MLXStatus_s MLX_STS = {.comm_sts = false, .count_check_meas = 0U, .refresh = 0U, .wait_time_meas = 1000};
+MLXStatus_s MLX_STS = {.comm_sts = false, .count_check_meas = 0U, .refresh = 0U, .conv_time_us = MLX90632_MEAS_MAX_TIME * 1000U,
+                       .mode = MLX90632_PWR_STATUS_SLEEP_STEP, .last_cycle_pos = 0, .last_ready_us = 0U,
+                       .meas_type = MLX90632_MTYP_MEDICAL};
+MLXPollStats_s MLX_POLL = {.last = 0U, .max = 0U, .total = 0U, .samples = 0U};
 
 
 static double emissivity = 0.0;
 
+/* i2c address of the sensor, keys its record in the calibration cache */
+static uint16_t mlx90632_cache_id = MLX90632_I2C_ADDR;
+
+/* Calibration table: eeprom address, word width, signedness, fixed-point shift and destination in MLXCalib_s */
+typedef struct{
+    uint16_t addr;
+    uint8_t width;
+    bool is_signed;
+    uint8_t shift;
+    size_t offset;
+    const char *name;
+}MLXCalibDesc_s;
+
+#define MLX90632_CALIB_DESC(coeff, ee_addr, bits, sign, frac) \
+    { .addr = (ee_addr), .width = (bits), .is_signed = (sign), .shift = (frac), .offset = offsetof(MLXCalib_s, coeff), .name = #coeff }
+
+//every constant is two's complement (int32 or int16 in the Melexis datasheet)
+static const MLXCalibDesc_s mlx90632_calib_table[] = {
+    MLX90632_CALIB_DESC(P_R, MLX90632_EE_P_R, 32, true, 8),
+    MLX90632_CALIB_DESC(P_G, MLX90632_EE_P_G, 32, true, 20),
+    MLX90632_CALIB_DESC(P_T, MLX90632_EE_P_T, 32, true, 44),
+    MLX90632_CALIB_DESC(P_O, MLX90632_EE_P_O, 32, true, 8),
+    MLX90632_CALIB_DESC(Ea, MLX90632_EE_Ea, 32, true, 16),
+    MLX90632_CALIB_DESC(Eb, MLX90632_EE_Eb, 32, true, 8),
+    MLX90632_CALIB_DESC(Fa, MLX90632_EE_Fa, 32, true, 46),
+    MLX90632_CALIB_DESC(Fb, MLX90632_EE_Fb, 32, true, 36),
+    MLX90632_CALIB_DESC(Ga, MLX90632_EE_Ga, 32, true, 36),
+    MLX90632_CALIB_DESC(Gb, MLX90632_EE_Gb, 16, true, 10),
+    MLX90632_CALIB_DESC(Ka, MLX90632_EE_Ka, 16, true, 10),
+    MLX90632_CALIB_DESC(Ha, MLX90632_EE_Ha, 16, true, 14),
+    MLX90632_CALIB_DESC(Hb, MLX90632_EE_Hb, 16, true, 14),
+};
+
 void i2c_melexis_decodeReg(uint16_t reg_addr, uint16_t data){
     if(reg_addr == 0x3001){//CTRL
         LOG_MLX("sob\tmeas select\tsoc\tmode");
@@ -67,7 +108,7 @@ uint16_t i2c_melexis_getStsReg(){
 
     ret = mlx90632_i2c_read(MLX90632_REG_STATUS, &reg_value);
     if (ret < 0){
-        LOG("Reading status register is failed with error code %i \n", ret); 
+        LOG("Reading status register is failed with error code %i", ret);
     } else {
         if (DEBUG_MLX){
             i2c_melexis_decodeReg(MLX90632_REG_STATUS, reg_value);
@@ -85,7 +126,7 @@ uint16_t i2c_melexis_getCtrlReg(){
     ret = mlx90632_i2c_read(MLX90632_REG_CTRL, &reg_value);
 
     if (ret < 0){
-        if(DEBUG_MLX)printk("Reading control register is failed with error code %i \n", ret);
+        LOG_MLX("Reading control register is failed with error code %i", ret);
         reg_value = 0xFFFF; //error during reading
     } else {
         if (DEBUG_MLX){
@@ -101,147 +142,120 @@ bool i2c_melexis_e2busy(){
     
     reg_value = i2c_melexis_getStsReg();
 
-    if (reg_value & ((uint32_t)1 << MLX90632_STAT_EE_BUSY)) return (true);
+    if (reg_value & MLX90632_STAT_EE_BUSY) return (true);
     return (false);
 }
 
 int32_t i2c_melexis_setmode(uint8_t mode){
-    int32_t ret = 0;
+    int32_t ret;
     uint16_t reg_ctrl;
+    int tries = MLX90632_MAX_NUMBER_MESUREMENT_READ_TRIES;
 
-    reg_ctrl = 0x00;
+    //keep the measurement type bits
+    ret = mlx90632_i2c_read(MLX90632_REG_CTRL, &reg_ctrl);
+    if (ret < 0)
+        return ret;
 
     while ((reg_ctrl & (uint16_t)(GENMASK(2,1))) != mode){
-        
-        reg_ctrl &= ~(mode); //Clear the mode bits
+        if (tries-- <= 0)
+            return -ETIMEDOUT;
+
+        reg_ctrl &= ~(MLX90632_CFG_PWR_MASK | MLX90632_CFG_SOC_MASK | MLX90632_CFG_SOB_MASK); //Clear the mode bits
         reg_ctrl |= mode; //Set the bits
         ret = mlx90632_i2c_write(MLX90632_REG_CTRL, reg_ctrl); //Set the mode bits
-        reg_ctrl = i2c_melexis_getCtrlReg();
+        if (ret < 0)
+            return ret;
+        ret = mlx90632_i2c_read(MLX90632_REG_CTRL, &reg_ctrl);
+        if (ret < 0)
+            return ret;
     }
-    return ret;       
+    return 0;
 }
 
-int32_t mlx90632_readCalib(){
+int32_t mlx90632_readEeprom(MLXEeprom_s *ee){
 
     int32_t ret;
-    uint16_t kalib_L;
-    uint16_t kalib_M;
-    
-    while(i2c_melexis_e2busy()){
-        //do nothing
-        //wait
-    }
-    i2c_melexis_setmode(MLX90632_PWR_STATUS_SLEEP_STEP);
 
-    ret = mlx90632_i2c_read(MLX90632_EE_P_R, &kalib_L);
-    if (ret < 0)
-        return ret;
-    ret = mlx90632_i2c_read((MLX90632_EE_P_R + 1), &kalib_M);
+    ret = mlx90632_i2c_read_block(MLX90632_EE_CALIB_START, ee->calib, MLX90632_EE_CALIB_LEN);
     if (ret < 0)
         return ret;
-    MLX_K.P_R = (((kalib_M << 16) | kalib_L) / (double)(1<<8));
-    LOG("P_R Kalibration = %.4f",MLX_K.P_R);
 
-    ret = mlx90632_i2c_read(MLX90632_EE_P_G, &kalib_L);
-    if (ret < 0)
-        return ret; 
-    ret = mlx90632_i2c_read((MLX90632_EE_P_G + 1), &kalib_M);
-    if (ret < 0)
-        return ret;
-    MLX_K.P_G = ((kalib_M << 16) | kalib_L) / (double)(1<<20);
-    LOG("P_G Kalibration = %.4f",MLX_K.P_G);
+    ret = mlx90632_i2c_read_block(MLX90632_EE_CUSTOMER_START, ee->customer, MLX90632_EE_CUSTOMER_LEN);
+    return ret;
+}
 
-    ret = mlx90632_i2c_read(MLX90632_EE_P_T, &kalib_L);
-    if (ret < 0)
-        return ret; 
-    ret = mlx90632_i2c_read((MLX90632_EE_P_T + 1), &kalib_M);
-    if (ret < 0)
-        return ret;
-    MLX_K.P_T = ((kalib_M << 16) | kalib_L) / (double)(1<<22);
-    MLX_K.P_T = MLX_K.P_T /(double)(1<<22);
-    LOG("P_T Kalibration = %.4f",MLX_K.P_T);
+static uint16_t mlx90632_ee_word(const MLXEeprom_s *ee, uint16_t addr){
+    if (addr >= MLX90632_EE_CUSTOMER_START)
+        return ee->customer[addr - MLX90632_EE_CUSTOMER_START];
+    return ee->calib[addr - MLX90632_EE_CALIB_START];
+}
 
-    ret = mlx90632_i2c_read(MLX90632_EE_P_O, &kalib_L);
-    if (ret < 0)
-        return ret; 
-    ret = mlx90632_i2c_read((MLX90632_EE_P_O + 1), &kalib_M);
-    if (ret < 0)
-        return ret;
-    MLX_K.P_O = ((kalib_M << 16) | kalib_L) / (double)(1<<8);
-    LOG("P_O Kalibration = %.4f",MLX_K.P_O);
+void mlx90632_decodeCalib(const MLXEeprom_s *ee, MLXCalib_s *calib){
 
-    ret = mlx90632_i2c_read(MLX90632_EE_Ea, &kalib_L);
-    if (ret < 0)
-        return ret; 
-    ret = mlx90632_i2c_read((MLX90632_EE_Ea + 1), &kalib_M);
-    if (ret < 0)
-        return ret;
-    MLX_K.Ea = ((kalib_M << 16) | kalib_L) / (double)(1<<16);
-    LOG("Ea Kalibration = %.4f",MLX_K.Ea);
+    size_t i;
+    int64_t raw;
+    float *coeff;
 
-    ret = mlx90632_i2c_read(MLX90632_EE_Eb, &kalib_L);
-    if (ret < 0)
-        return ret; 
-    ret = mlx90632_i2c_read((MLX90632_EE_Eb + 1), &kalib_M);
-    if (ret < 0)
-        return ret;
-    MLX_K.Eb = ((kalib_M << 16) | kalib_L) / (double)(1<<8);
-    LOG("Eb Kalibration = %.4f",MLX_K.Eb);
+    for (i = 0; i < ARRAY_SIZE(mlx90632_calib_table); i++){
+        const MLXCalibDesc_s *desc = &mlx90632_calib_table[i];
 
-    ret = mlx90632_i2c_read(MLX90632_EE_Fa, &kalib_L);
-    if (ret < 0)
-        return ret; 
-    ret = mlx90632_i2c_read((MLX90632_EE_Fa + 1), &kalib_M);
-    if (ret < 0)
-        return ret;
-    MLX_K.Fa = ((kalib_M << 16) | kalib_L);
-    MLX_K.Fa = MLX_K.Fa / (double)(1<<23);
-    MLX_K.Fa = MLX_K.Fa /(double)(1<<23);
-    LOG("Fa Kalibration = %.4f",MLX_K.Fa);
+        if (desc->width == 32){
+            //LSW first, MSW at next address
+            raw = ((int64_t)mlx90632_ee_word(ee, desc->addr + 1) << 16) | mlx90632_ee_word(ee, desc->addr);
+            if (desc->is_signed)
+                raw = (int32_t)(uint32_t)raw;
+        } else {
+            raw = mlx90632_ee_word(ee, desc->addr);
+            if (desc->is_signed)
+                raw = (int16_t)(uint16_t)raw;
+        }
 
-    ret = mlx90632_i2c_read(MLX90632_EE_Fb, &kalib_L);
-    if (ret < 0)
-        return ret; 
-    ret = mlx90632_i2c_read((MLX90632_EE_Fb + 1), &kalib_M);
-    if (ret < 0)
-        return ret;
-    MLX_K.Fb = ((kalib_M << 16) | kalib_L) / (double)(1<<18);
-    MLX_K.Fb = MLX_K.Fb /(double)(1<<18);
-    LOG("Fb Kalibration = %.4f",MLX_K.Fb);
+        coeff = (float *)((uint8_t *)calib + desc->offset);
+        *coeff = (float)ldexp((double)raw, -desc->shift);
+    }
+}
 
-    ret = mlx90632_i2c_read(MLX90632_EE_Ga, &kalib_L);
-    if (ret < 0)
-        return ret; 
-    ret = mlx90632_i2c_read((MLX90632_EE_Ga + 1), &kalib_M);
+/* EE_BUSY is set for the whole write cycle */
+static int32_t mlx90632_wait_eeprom(void){
+    int32_t ret;
+    int tries = MLX90632_TIMING_EEPROM;
+    uint16_t reg_status;
+
+    while (tries-- > 0){
+        usleep(1000, 1000);
+        ret = mlx90632_i2c_read(MLX90632_REG_STATUS, &reg_status);
+        if (ret < 0)
+            return ret;
+        if (!(reg_status & MLX90632_STAT_EE_BUSY))
+            return 0;
+    }
+    return -ETIMEDOUT;
+}
+
+int32_t mlx90632_readCalib(){
+
+    int32_t ret;
+    size_t i;
+    MLXEeprom_s ee;
+    
+    ret = mlx90632_wait_eeprom();
     if (ret < 0)
         return ret;
-    MLX_K.Ga = ((kalib_M << 16) | kalib_L) / (double)(1<<18);
-    MLX_K.Ga = MLX_K.Ga /(double)(1<<18);
-    LOG("Ga Kalibration = %.4f",MLX_K.Ga);
-
-    ret = mlx90632_i2c_read(MLX90632_EE_Gb, &kalib_L);
+    ret = i2c_melexis_setmode(MLX90632_PWR_STATUS_SLEEP_STEP);
     if (ret < 0)
-        return ret; 
-    MLX_K.Gb = (kalib_L) / (double)(1<<10);
-    LOG("Gb Kalibration = %.4f",MLX_K.Gb);
+        return ret;
 
-    ret = mlx90632_i2c_read(MLX90632_EE_Ka, &kalib_L);
+    ret = mlx90632_readEeprom(&ee);
     if (ret < 0)
-        return ret; 
-    MLX_K.Ka = (kalib_L) / (double)(1<<10);
-    LOG("Ka Kalibration = %.4f",MLX_K.Ka);
+        return ret;
 
-    ret = mlx90632_i2c_read(MLX90632_EE_Ha, &kalib_L);
-    if (ret < 0)
-        return ret; 
-    MLX_K.Ha = (kalib_L) / (double)(1<<14);
-    LOG("Ha Kalibration = %.4f",MLX_K.Ha);
+    mlx90632_decodeCalib(&ee, &MLX_K);
+    mlx90632_cache_store(mlx90632_cache_id, &ee, &MLX_K);
 
-    ret = mlx90632_i2c_read(MLX90632_EE_Hb, &kalib_L);
-    if (ret < 0)
-        return ret; 
-    MLX_K.Hb = (kalib_L) / (double)(1<<14);
-    LOG("Hb Kalibration = %.4f",MLX_K.Hb);
+    for (i = 0; i < ARRAY_SIZE(mlx90632_calib_table); i++){
+        LOG("%s Kalibration = %.4f", mlx90632_calib_table[i].name,
+            *(const float *)((const uint8_t *)&MLX_K + mlx90632_calib_table[i].offset));
+    }
 
     return 0;
     
@@ -268,13 +282,124 @@ mlx90632_meas_t mlx90632_get_refresh_rate(void){
     int32_t ret;
     uint16_t meas1;
 
-    ret = mlx90632_i2c_read(MLX90632_EE_MEDICAL_MEAS1, &meas1);
+    //the refresh rate is the same for every measurement of a table
+    if (MLX90632_MEASUREMENT_TYPE_STATUS(MLX_STS.meas_type) == MLX90632_MTYP_EXTENDED)
+        ret = mlx90632_i2c_read(MLX90632_EE_EXTENDED_MEAS1, &meas1);
+    else
+        ret = mlx90632_i2c_read(MLX90632_EE_MEDICAL_MEAS1, &meas1);
     if (ret < 0)
         return MLX90632_MEAS_HZ_ERROR;
 
     return (mlx90632_meas_t)MLX90632_REFRESH_RATE(meas1);
 }
 
+/* Erase then program, each write needs its own unlock */
+static int32_t mlx90632_eeprom_program(uint16_t addr, uint16_t value){
+    int32_t ret;
+
+    ret = mlx90632_i2c_write(MLX90632_REG_CMD, MLX90632_EEPROM_WRITE_KEY);
+    if (ret < 0)
+        return ret;
+    ret = mlx90632_i2c_write(addr, 0x0000);
+    if (ret < 0)
+        return ret;
+    ret = mlx90632_wait_eeprom();
+    if (ret < 0)
+        return ret;
+
+    ret = mlx90632_i2c_write(MLX90632_REG_CMD, MLX90632_EEPROM_WRITE_KEY);
+    if (ret < 0)
+        return ret;
+    ret = mlx90632_i2c_write(addr, value);
+    if (ret < 0)
+        return ret;
+    return mlx90632_wait_eeprom();
+}
+
+/* A failure after the erase leaves the word at 0x0000, old_value is programmed back */
+static int32_t mlx90632_eeprom_update(uint16_t addr, uint16_t old_value, uint16_t value){
+    int32_t ret;
+    int tries = MLX90632_EEPROM_RESTORE_TRIES;
+
+    ret = mlx90632_eeprom_program(addr, value);
+    if (ret == 0)
+        return 0;
+
+    while (tries-- > 0){
+        if (mlx90632_eeprom_program(addr, old_value) == 0)
+            return ret;
+    }
+    LOG("EEPROM word 0x%04X not restored to 0x%04X", addr, old_value);
+    return -EFAULT;
+}
+
+int32_t mlx90632_eeprom_write(uint16_t addr, uint16_t value){
+    int32_t ret;
+    uint16_t old_value;
+
+    ret = mlx90632_i2c_read(addr, &old_value);
+    if (ret < 0)
+        return ret;
+    return mlx90632_eeprom_update(addr, old_value, value);
+}
+
+int32_t mlx90632_set_refresh_rate(mlx90632_meas_t rate){
+    static const uint16_t medical[] = { MLX90632_EE_MEDICAL_MEAS1, MLX90632_EE_MEDICAL_MEAS2 };
+    static const uint16_t extended[] = { MLX90632_EE_EXTENDED_MEAS1, MLX90632_EE_EXTENDED_MEAS2, MLX90632_EE_EXTENDED_MEAS3 };
+    const uint16_t *meas = medical;
+    size_t i, count = ARRAY_SIZE(medical);
+    uint16_t old_value[MLX90632_EXTENDED_TABLE_LEN], new_value[MLX90632_EXTENDED_TABLE_LEN];
+    uint32_t written = 0;
+    int32_t ret = 0;
+
+    if ((rate < MLX90632_MEAS_HZ_HALF) || (rate > MLX90632_MEAS_HZ_64))
+        return -EINVAL;
+
+    if (MLX90632_MEASUREMENT_TYPE_STATUS(MLX_STS.meas_type) == MLX90632_MTYP_EXTENDED){
+        meas = extended;
+        count = ARRAY_SIZE(extended);
+    }
+
+    for (i = 0; i < count; i++){
+        ret = mlx90632_i2c_read(meas[i], &old_value[i]);
+        if (ret < 0)
+            break;
+
+        new_value[i] = MLX90632_NEW_REG_VALUE(old_value[i], (uint16_t)rate, MLX90632_EE_REFRESH_RATE_START, MLX90632_EE_REFRESH_RATE_SHIFT);
+        if (new_value[i] == old_value[i])
+            continue;
+
+        ret = mlx90632_eeprom_update(meas[i], old_value[i], new_value[i]);
+        if (ret < 0)
+            break;
+        written |= BIT(i);
+    }
+
+    if (ret < 0){
+        //every measurement of the table keeps the old rate
+        while (i-- > 0){
+            if ((written & BIT(i)) && (mlx90632_eeprom_update(meas[i], new_value[i], old_value[i]) < 0))
+                ret = -EFAULT;
+        }
+        return ret;
+    }
+
+    if (written){
+        //the measurement table is loaded from EEPROM at reset
+        ret = mlx90632_addressed_reset();
+        if (ret < 0)
+            return ret;
+    }
+
+    MLX_STS.refresh = (uint8_t)rate;
+    MLX_STS.conv_time_us = mlx90632_calc_conv_time(rate);
+    if (!written)
+        return 0;
+
+    LOG("Refresh Value set to %d", MLX_STS.refresh);
+    return 1;
+}
+
 int32_t mlx90632_addressed_reset(void){
     int32_t ret;
     uint16_t reg_ctrl;
@@ -292,7 +417,7 @@ int32_t mlx90632_addressed_reset(void){
         return ret;
     //MLX90632_RESET_CMD
     reg_ctrl = MLX90632_RESET_CMD;
-    ret = mlx90632_i2c_write(0x3005, reg_ctrl);
+    ret = mlx90632_i2c_write(MLX90632_REG_CMD, reg_ctrl);
     if (ret < 0)
         return ret;
 
@@ -329,11 +454,19 @@ int32_t mlx90632_init(void){
         LOG("Error: Communication failure. Check wiring. Expected device address: 0x%X, instead read 0x%X",58,(reg_status<<1));
         return -1;
     }
+    mlx90632_cache_id = (uint16_t)(reg_status << 1);
 
     MLX_STS.refresh = mlx90632_get_refresh_rate();
     LOG("Refresh Value is %d",MLX_STS.refresh);
+    MLX_STS.conv_time_us = mlx90632_calc_conv_time((mlx90632_meas_t)MLX_STS.refresh);
 
-    mlx90632_readCalib();
+    //warm boot: cached calibration is used if sensor fingerprint matches
+    if (mlx90632_cache_load(mlx90632_cache_id, &MLX_K) < 0){
+        ret = mlx90632_readCalib();
+        if (ret < 0)
+            return ret;
+    }
+    mlx90632_kernel_prepare();
     
     ret = i2c_melexis_setmode(MLX90632_PWR_STATUS_SLEEP_STEP);
     if (ret < 0)
@@ -351,7 +484,21 @@ int32_t mlx90632_init(void){
 
     if ((eeprom_version & 0x7F00) == MLX90632_XTD_RNG_KEY)
     {
-        return ERANGE;
+        LOG("Extended range sensor");
+        if (MLX_EXTENDED){
+            //sets refresh rate and conversion time of the extended table, continuous or burst as the medical one
+            ret = mlx90632_set_meas_type(MLX_CONTINUOUS ? MLX90632_MTYP_EXTENDED : MLX90632_MTYP_EXTENDED_BURST);
+            if (ret < 0)
+                return ret;
+
+            //continuous acquisition is started by mlx90632_start_continuous(), as in medical range
+            if (MLX_STS.mode != MLX90632_PWR_STATUS_SLEEP_STEP){
+                ret = i2c_melexis_setmode(MLX90632_PWR_STATUS_SLEEP_STEP);
+                if (ret < 0)
+                    return ret;
+                MLX_STS.mode = MLX90632_PWR_STATUS_SLEEP_STEP;
+            }
+        }
     }
 
     LOG("Sensor Initialized.");
@@ -380,6 +527,8 @@ int mlx90632_start_measurement(){
     int ret, tries = MLX90632_MAX_NUMBER_MESUREMENT_READ_TRIES;
     int meas_ret;
     uint16_t reg_status, reg_ctrl;
+    uint16_t polls;
+    uint32_t margin, poll_interval;
 
     mlx90632_check_i2c_comm();
 
@@ -410,20 +559,28 @@ int mlx90632_start_measurement(){
         MLX_STS.error = MLX_STS.error & (~ERROR_MLX_WRITE);
     }*/
 
+    //sleep once until just before data ready
+    margin = MLX_STS.conv_time_us / MLX90632_WAKEUP_MARGIN_DIV;
+    poll_interval = MAX(MLX_STS.conv_time_us / MLX90632_POLL_INTERVAL_DIV, MLX90632_MIN_POLL_INTERVAL);
+    usleep(MLX_STS.conv_time_us - margin, MLX_STS.conv_time_us - margin);
+
+    polls = 0;
     while (tries-- > 0) {
-        mlx90632_i2c_read(MLX90632_REG_STATUS, &reg_status);
+        polls++;
+        ret = mlx90632_i2c_read(MLX90632_REG_STATUS, &reg_status);
 
         //Check if data is ready    
-        if (reg_status & MLX90632_STAT_DATA_RDY)
+        if ((ret == 0) && (reg_status & MLX90632_STAT_DATA_RDY))
             break;
-        /* minimum wait time to complete measurement
-         * should be calculated according to refresh rate
-         * atm 10ms - 11ms
-         */
-        usleep(MLX_STS.wait_time_meas, MLX_STS.wait_time_meas + 100);
-        //msleep(1);
+
+        usleep(poll_interval, poll_interval);
     }
 
+    MLX_POLL.last = polls;
+    MLX_POLL.max = MAX(MLX_POLL.max, polls);
+    MLX_POLL.total += polls;
+    MLX_POLL.samples++;
+
     if (tries < 0){
         // data not ready
         return -ETIMEDOUT;
@@ -433,36 +590,309 @@ int mlx90632_start_measurement(){
     return meas_ret;
 }
 
+int32_t mlx90632_start_measurement_burst(void){
+    int32_t ret;
+    int tries = MLX90632_MAX_NUMBER_MESUREMENT_READ_TRIES;
+    uint16_t reg_ctrl, reg_status;
+    uint16_t polls;
+    uint32_t table_time, margin, poll_interval;
+
+    mlx90632_check_i2c_comm();
+
+    ret = mlx90632_i2c_read(MLX90632_REG_CTRL, &reg_ctrl);
+    if (ret < 0)
+        return ret;
+
+    ret = mlx90632_i2c_write(MLX90632_REG_CTRL, reg_ctrl | MLX90632_START_BURST_MEAS);
+    if (ret < 0)
+        return ret;
+
+    //sleep once until just before the last measurement of the table completes
+    if (MLX90632_MEASUREMENT_TYPE_STATUS(MLX_STS.meas_type) == MLX90632_MTYP_EXTENDED)
+        table_time = MLX_STS.conv_time_us * MLX90632_EXTENDED_TABLE_LEN;
+    else
+        table_time = MLX_STS.conv_time_us * MLX90632_MEDICAL_TABLE_LEN;
+    margin = MLX_STS.conv_time_us / MLX90632_WAKEUP_MARGIN_DIV;
+    poll_interval = MAX(MLX_STS.conv_time_us / MLX90632_POLL_INTERVAL_DIV, MLX90632_MIN_POLL_INTERVAL);
+    usleep(table_time - margin, table_time - margin);
+
+    polls = 0;
+    while (tries-- > 0) {
+        polls++;
+        ret = mlx90632_i2c_read(MLX90632_REG_STATUS, &reg_status);
+
+        //the sensor is back asleep when the table is measured
+        if ((ret == 0) && !(reg_status & MLX90632_STAT_BUSY))
+            break;
+
+        usleep(poll_interval, poll_interval);
+    }
+
+    MLX_POLL.last = polls;
+    MLX_POLL.max = MAX(MLX_POLL.max, polls);
+    MLX_POLL.total += polls;
+    MLX_POLL.samples++;
+
+    if (tries < 0)
+        return -ETIMEDOUT;
+
+    return 0;
+}
+
+static uint64_t mlx90632_now_us(void){
+    const MLXBus_s *bus = mlx90632_bus_get();
+
+    return bus->now_us(bus->ctx);
+}
+
+int32_t mlx90632_start_continuous(void){
+    int32_t ret;
+    uint16_t reg_status;
+
+    ret = i2c_melexis_setmode(MLX90632_PWR_STATUS_CONTINUOUS);
+    if (ret < 0)
+        return ret;
+
+    //data ready left from sleeping step mode is not a new sample
+    ret = mlx90632_i2c_read(MLX90632_REG_STATUS, &reg_status);
+    if (ret < 0)
+        return ret;
+    ret = mlx90632_i2c_write(MLX90632_REG_STATUS, reg_status & ~MLX90632_STAT_DATA_RDY);
+    if (ret < 0)
+        return ret;
+
+    MLX_STS.mode = MLX90632_PWR_STATUS_CONTINUOUS;
+    MLX_STS.last_cycle_pos = 0;
+    MLX_STS.last_ready_us = mlx90632_now_us();
+    return 0;
+}
+
+int32_t mlx90632_stop_continuous(void){
+    MLX_STS.mode = MLX90632_PWR_STATUS_SLEEP_STEP;
+    return i2c_melexis_setmode(MLX90632_PWR_STATUS_SLEEP_STEP);
+}
+
+int mlx90632_wait_continuous(void){
+    int32_t ret;
+    int tries = MLX90632_MAX_NUMBER_MESUREMENT_READ_TRIES;
+    int cycle_pos = 0;
+    uint16_t reg_status;
+    uint16_t polls = 0;
+    uint64_t elapsed, wake;
+    uint32_t poll_interval;
+    bool extended = MLX90632_MEASUREMENT_TYPE_STATUS(MLX_STS.meas_type) == MLX90632_MTYP_EXTENDED;
+
+    if (!MLX_STS.comm_sts){
+        //init sets sleeping step mode, restart continuous after recovery
+        mlx90632_check_i2c_comm();
+        if (!MLX_STS.comm_sts)
+            return -EIO;
+        ret = mlx90632_start_continuous();
+        if (ret < 0)
+            return ret;
+    }
+
+    //sleep until just before next cycle position completes, the whole table in extended range
+    wake = MLX_STS.conv_time_us - MLX_STS.conv_time_us / MLX90632_WAKEUP_MARGIN_DIV;
+    if (extended)
+        wake += (uint64_t)MLX_STS.conv_time_us * (MLX90632_EXTENDED_TABLE_LEN - 1);
+    elapsed = mlx90632_now_us() - MLX_STS.last_ready_us;
+    if (elapsed < wake)
+        usleep((int)(wake - elapsed), (int)(wake - elapsed));
+
+    poll_interval = MAX(MLX_STS.conv_time_us / MLX90632_POLL_INTERVAL_DIV, MLX90632_MIN_POLL_INTERVAL);
+    while (tries-- > 0) {
+        polls++;
+        ret = mlx90632_i2c_read(MLX90632_REG_STATUS, &reg_status);
+        if (ret < 0){
+            MLX_STS.comm_sts = false;
+            return ret;
+        }
+
+        //new data when data ready is set, the cycle position only selects the RAM bank
+        //extended range: one sample per table, when its last position is measured
+        cycle_pos = (int)(reg_status & (uint16_t)MLX90632_STAT_CYCLE_POS) >> 2;
+        if ((reg_status & MLX90632_STAT_DATA_RDY) &&
+            (extended ? (cycle_pos == MLX90632_EXTENDED_LAST_POS) : ((cycle_pos == 1) || (cycle_pos == 2))))
+            break;
+
+        usleep(poll_interval, poll_interval);
+    }
+
+    MLX_POLL.last = polls;
+    MLX_POLL.max = MAX(MLX_POLL.max, polls);
+    MLX_POLL.total += polls;
+    MLX_POLL.samples++;
+
+    if (tries < 0)
+        return -ETIMEDOUT;
+
+    MLX_STS.last_cycle_pos = (int8_t)cycle_pos;
+    MLX_STS.last_ready_us = mlx90632_now_us();
+
+    if (extended)
+        ret = mlx90632_readTempRawExtendedRam(&MLX_T_RAW);
+    else
+        ret = mlx90632_getTempRaw(cycle_pos);
+    if (ret == -EINVAL){
+        //combined object out of range, the sample is dropped but the bus is fine
+        mlx90632_i2c_write(MLX90632_REG_STATUS, reg_status & ~MLX90632_STAT_DATA_RDY);
+        return ret;
+    }
+    if (ret < 0){
+        MLX_STS.comm_sts = false;
+        return ret;
+    }
+
+    //cleared only once the RAM words are read, next set means next cycle position
+    ret = mlx90632_i2c_write(MLX90632_REG_STATUS, reg_status & ~MLX90632_STAT_DATA_RDY);
+    if (ret < 0){
+        MLX_STS.comm_sts = false;
+        return ret;
+    }
+
+    return cycle_pos;
+}
+
+int mlx90632_read_continuous(void){
+    int cycle_pos;
+
+    cycle_pos = mlx90632_wait_continuous();
+    if (cycle_pos < 0){
+        LOG("Reading continuous Temp failed with error code %d", cycle_pos);
+        return cycle_pos;
+    }
+
+    mlx90632_calc_temp_kernel(&MLX_T_RAW, &MLX_T);
+    LOG_MLX("Cycle %d ambient %.4f object %.4f", cycle_pos, MLX_T.ambient, MLX_T.object);
+
+    return cycle_pos;
+}
+
 int32_t mlx90632_ambTempRaw(){
 
     int32_t ret;
-    uint16_t tmp_temp;
+    uint16_t ram[4];
 
-    ret = mlx90632_i2c_read(MLX90632_RAM_3(1), &tmp_temp);
+    //RAM_6..RAM_9 in one transaction
+    ret = mlx90632_i2c_read_block(MLX90632_RAM_3(1), ram, ARRAY_SIZE(ram));
     if (ret < 0)
         return ret;
-    MLX_T_RAW.ambient_ram_6 = (int16_t)tmp_temp;
+    MLX_T_RAW.ambient_ram_6 = (int16_t)ram[0];
+    MLX_T_RAW.ambient_ram_9 = (int16_t)ram[3];
+
+    return ret;
+}
 
-    ret = mlx90632_i2c_read(MLX90632_RAM_3(2), &tmp_temp);
+int32_t mlx90632_readTempRaw(int cycle_pos, MLXTempRaw_s *raw){
+
+    int32_t ret;
+    uint16_t ram[MLX90632_RAM_BLOCK_LEN];
+
+    if ((cycle_pos != 1) && (cycle_pos != 2))
+        return -EINVAL;
+
+    ret = mlx90632_i2c_read_block(MLX90632_RAM_BLOCK_START, ram, MLX90632_RAM_BLOCK_LEN);
     if (ret < 0)
         return ret;
-    MLX_T_RAW.ambient_ram_9 = (int16_t)tmp_temp;
+
+    mlx90632_decodeTempRaw(cycle_pos, ram, raw);
 
     return ret;
 }
 
+void mlx90632_decodeTempRaw(int cycle_pos, const uint16_t *ram, MLXTempRaw_s *raw){
+    raw->ambient_ram_6 = (int16_t)ram[MLX90632_RAM_BLOCK_IDX(MLX90632_RAM_3(1))];
+    raw->ambient_ram_9 = (int16_t)ram[MLX90632_RAM_BLOCK_IDX(MLX90632_RAM_3(2))];
+    raw->object_ram_4_7 = (int16_t)ram[MLX90632_RAM_BLOCK_IDX(MLX90632_RAM_1(cycle_pos))];
+    raw->object_ram_5_8 = (int16_t)ram[MLX90632_RAM_BLOCK_IDX(MLX90632_RAM_2(cycle_pos))];
+}
 
-double mlx90632_calc_temp_ambient(double Gb, double PO, double PR, double PG,  double PT){
+int32_t mlx90632_readTempRawExtended(MLXTempRaw_s *raw){
+
+    int32_t ret;
+
+    ret = mlx90632_start_measurement_burst();
+    if (ret < 0)
+        return ret;
+
+    return mlx90632_readTempRawExtendedRam(raw);
+}
+
+int32_t mlx90632_readTempRawExtendedRam(MLXTempRaw_s *raw){
+
+    int32_t ret;
+    uint16_t ram[MLX90632_RAM_EXT_BLOCK_LEN];
+
+    ret = mlx90632_i2c_read_block(MLX90632_RAM_EXT_BLOCK_START, ram, MLX90632_RAM_EXT_BLOCK_LEN);
+    if (ret < 0)
+        return ret;
+
+    return mlx90632_decodeTempRawExtended(ram, raw);
+}
+
+int mlx90632_read_burst(MLXBurst_s *burst){
+
+    int32_t ret;
+    uint16_t ram[MLX90632_RAM_BLOCK_LEN];
+    int i;
+
+    burst->count = 0;
+    if (MLX90632_MEASUREMENT_TYPE_STATUS(MLX_STS.meas_type) == MLX90632_MTYP_EXTENDED){
+        ret = mlx90632_readTempRawExtended(&burst->raw[0]);
+        if (ret < 0)
+            return ret;
+        burst->cycle_pos[0] = MLX90632_EXTENDED_LAST_POS;
+        burst->count = 1;
+        return burst->count;
+    }
+
+    ret = mlx90632_start_measurement_burst();
+    if (ret < 0)
+        return ret;
+
+    ret = mlx90632_i2c_read_block(MLX90632_RAM_BLOCK_START, ram, MLX90632_RAM_BLOCK_LEN);
+    if (ret < 0)
+        return ret;
+
+    for (i = 0; i < MLX90632_MEDICAL_TABLE_LEN; i++){
+        mlx90632_decodeTempRaw(i + 1, ram, &burst->raw[i]);
+        burst->cycle_pos[i] = (uint8_t)(i + 1);
+    }
+    burst->count = MLX90632_MEDICAL_TABLE_LEN;
+    return burst->count;
+}
+
+int32_t mlx90632_decodeTempRawExtended(const uint16_t *ram, MLXTempRaw_s *raw){
+    int32_t object;
+
+    object = (int16_t)ram[MLX90632_RAM_EXT_BLOCK_IDX(MLX90632_RAM_1(17))]
+           - (int16_t)ram[MLX90632_RAM_EXT_BLOCK_IDX(MLX90632_RAM_2(17))]
+           - (int16_t)ram[MLX90632_RAM_EXT_BLOCK_IDX(MLX90632_RAM_1(18))];
+    object = (object + (int16_t)ram[MLX90632_RAM_EXT_BLOCK_IDX(MLX90632_RAM_2(18))]) / 2;
+    object += (int16_t)ram[MLX90632_RAM_EXT_BLOCK_IDX(MLX90632_RAM_1(19))];
+    object += (int16_t)ram[MLX90632_RAM_EXT_BLOCK_IDX(MLX90632_RAM_2(19))];
+    if ((object > INT16_MAX) || (object < INT16_MIN))
+        return -EINVAL;
+
+    raw->ambient_ram_6 = (int16_t)ram[MLX90632_RAM_EXT_BLOCK_IDX(MLX90632_RAM_3(17))];
+    raw->ambient_ram_9 = (int16_t)ram[MLX90632_RAM_EXT_BLOCK_IDX(MLX90632_RAM_3(18))];
+    raw->object_ram_4_7 = (int16_t)object;
+    raw->object_ram_5_8 = (int16_t)object;
+    return 0;
+}
+
+int32_t mlx90632_getTempRaw(int cycle_pos){
+    return mlx90632_readTempRaw(cycle_pos, &MLX_T_RAW);
+}
 
-    /*double VRta = MLX_T_RAW.ambient_ram_9 + MLX_K.Gb * (MLX_T_RAW.ambient_ram_6 / 12.0);
-    double AMB = (MLX_T_RAW.ambient_ram_6 / 12.0) / VRta * ((double)(1<<19));
-    double TAMB = MLX_K.P_O + (AMB - MLX_K.P_R) / MLX_K.P_G + MLX_K.P_T * pow((AMB - MLX_K.P_R), 2);*/
 
+double mlx90632_calc_temp_ambient_raw(const MLXTempRaw_s *raw, double Gb, double PO, double PR, double PG,  double PT){
 
     double VR_Ta, AMB, TAMB = 0.0;
 
-    VR_Ta = MLX_T_RAW.ambient_ram_9 + Gb * (MLX_T_RAW.ambient_ram_6  / (MLX90632_REF_3));
-    AMB = (MLX_T_RAW.ambient_ram_6 / (MLX90632_REF_3)) / VR_Ta * 524288.0;
+    VR_Ta = raw->ambient_ram_9 + Gb * (raw->ambient_ram_6  / (MLX90632_REF_3));
+    AMB = (raw->ambient_ram_6 / (MLX90632_REF_3)) / VR_Ta * 524288.0;
 
     TAMB = PO + ((AMB - PR )/ PG ) + PT * ((AMB - PR ) * (AMB - PR ));
 
@@ -470,6 +900,15 @@ double mlx90632_calc_temp_ambient(double Gb, double PO, double PR, double PG,  d
     return TAMB;
 }
 
+double mlx90632_calc_temp_ambient(double Gb, double PO, double PR, double PG,  double PT){
+
+    /*double VRta = MLX_T_RAW.ambient_ram_9 + MLX_K.Gb * (MLX_T_RAW.ambient_ram_6 / 12.0);
+    double AMB = (MLX_T_RAW.ambient_ram_6 / 12.0) / VRta * ((double)(1<<19));
+    double TAMB = MLX_K.P_O + (AMB - MLX_K.P_R) / MLX_K.P_G + MLX_K.P_T * pow((AMB - MLX_K.P_R), 2);*/
+
+    return mlx90632_calc_temp_ambient_raw(&MLX_T_RAW, Gb, PO, PR, PG, PT);
+}
+
 int32_t mlx90632_gatherAmbTemp(){
 
     int32_t ret;
@@ -487,53 +926,36 @@ int32_t mlx90632_gatherAmbTemp(){
 int32_t mlx90632_getObjTempRaw(int cycle_pos){
     
     int32_t ret = 0;
-    uint16_t tmp_temp;
+    uint16_t ram[2];
     
-    if (cycle_pos == 1)
+    //If cycle_pos = 1 object values are in RAM_4, RAM_5
+    //If cycle_pos = 2 object values are in RAM_7, RAM_8
+    if ((cycle_pos == 1) || (cycle_pos == 2))
     {
-        ret = mlx90632_i2c_read(MLX90632_RAM_1(cycle_pos), &tmp_temp);
+        ret = mlx90632_i2c_read_block(MLX90632_RAM_1(cycle_pos), ram, ARRAY_SIZE(ram));
         if (ret < 0)
             return ret;
-        MLX_T_RAW.object_ram_4_7 = (int16_t)tmp_temp;
-
-        ret = mlx90632_i2c_read(MLX90632_RAM_2(cycle_pos), &tmp_temp);
-        if (ret < 0)
-            return ret;
-        MLX_T_RAW.object_ram_5_8 = (int16_t)tmp_temp;
-    }
-    //If cycle_pos = 2
-    //Calculate TA and TO based on RAM_7, RAM_8, RAM_6, RAM_9
-    else if (cycle_pos == 2)
-    {
-        ret = mlx90632_i2c_read(MLX90632_RAM_1(cycle_pos), &tmp_temp);
-        if (ret < 0)
-            return ret;
-        MLX_T_RAW.object_ram_4_7 = (int16_t)tmp_temp;
-
-        ret = mlx90632_i2c_read(MLX90632_RAM_2(cycle_pos), &tmp_temp);
-        if (ret < 0)
-            return ret;
-        MLX_T_RAW.object_ram_5_8 = (int16_t)tmp_temp;
-
+        MLX_T_RAW.object_ram_4_7 = (int16_t)ram[0];
+        MLX_T_RAW.object_ram_5_8 = (int16_t)ram[1];
     }else{}
 
     return ret;
 }
 
 
-double mlx90632_calc_temp_object(double Ka, double Gb, double Ea, double Eb, double Fa, double Ha, double Ga, double Fb, double Hb){
+double mlx90632_calc_temp_object_raw(const MLXTempRaw_s *raw, double Ka, double Gb, double Ea, double Eb, double Fa, double Ha, double Ga, double Fb, double Hb){
     double S, VRto, Sto;
     double VRta, AMB;
     double TAdut, TAk4;
     double emi = mlx90632_get_emissivity();
     double obj_temp;
 
-    S = (MLX_T_RAW.object_ram_4_7 + MLX_T_RAW.object_ram_5_8) / 2.0;
-    VRto = MLX_T_RAW.ambient_ram_9 + Ka * (MLX_T_RAW.ambient_ram_6 / MLX90632_REF_3);
+    S = (raw->object_ram_4_7 + raw->object_ram_5_8) / 2.0;
+    VRto = raw->ambient_ram_9 + Ka * (raw->ambient_ram_6 / MLX90632_REF_3);
     Sto = (S / 12.0) / VRto * (double)(1<<19);
 
-    VRta = MLX_T_RAW.ambient_ram_9 + Gb * (MLX_T_RAW.ambient_ram_6 / MLX90632_REF_3);
-    AMB = (MLX_T_RAW.ambient_ram_6 / MLX90632_REF_3) / VRta * (double)(1<<19);
+    VRta = raw->ambient_ram_9 + Gb * (raw->ambient_ram_6 / MLX90632_REF_3);
+    AMB = (raw->ambient_ram_6 / MLX90632_REF_3) / VRta * (double)(1<<19);
 
     TAdut = ((AMB - Eb) / Ea ) + 25;
     TAk4 = (TAdut + 273.15) * (TAdut + 273.15) * (TAdut + 273.15) * (TAdut + 273.15);
@@ -543,6 +965,10 @@ double mlx90632_calc_temp_object(double Ka, double Gb, double Ea, double Eb, dou
     return obj_temp;
 }
 
+double mlx90632_calc_temp_object(double Ka, double Gb, double Ea, double Eb, double Fa, double Ha, double Ga, double Fb, double Hb){
+    return mlx90632_calc_temp_object_raw(&MLX_T_RAW, Ka, Gb, Ea, Eb, Fa, Ha, Ga, Fb, Hb);
+}
+
 
 double mlx90632_calc_temp_object_iteration(double Sto, double emi, double Fa, double Ha, double Ga, double Fb, double TAdut, double TAk4, double Hb){
     
@@ -580,31 +1006,37 @@ void mlx90632_read(){
     int32_t ret;
     int start_measurement_ret;
 
+    if (MLX90632_MEASUREMENT_TYPE_STATUS(MLX_STS.meas_type) == MLX90632_MTYP_EXTENDED){
+        ret = mlx90632_readTempRawExtended(&MLX_T_RAW);
+        mlx90632_checkTimeout(ret);
+        if (ret < 0){
+            LOG("Reading extended Temp failed with error code %d", ret);
+            return;
+        }
+
+        mlx90632_calc_temp_kernel(&MLX_T_RAW, &MLX_T);
+        LOG("Ambient temperature measured value: %.4f", MLX_T.ambient);
+        LOG("Object temperature measured value: %.4f", MLX_T.object);
+        return;
+    }
 
     // trigger and wait for measurement to complete
     start_measurement_ret = mlx90632_start_measurement();
     
     
-    mlx90632_searchWaitTime(start_measurement_ret);
+    mlx90632_checkTimeout(start_measurement_ret);
 
     if (start_measurement_ret >= 0)
     {
-        ret = mlx90632_gatherAmbTemp();
+        ret = mlx90632_getTempRaw(start_measurement_ret);
         if (ret < 0){
-            LOG("Reading Amb Temp failed");
-        }else {
-            LOG("Ambient temperature measured value: %.4f", MLX_T.ambient);
-            //LOG("Temp Amb = %3.2f",MLX_T.ambient);
+            LOG("Reading Temp failed");
+            return;
         }
-        
 
-        ret = mlx90632_readObjTemp(start_measurement_ret);
-        if (ret < 0){
-            LOG("Reading Object Temp failed");
-        }else {
-            LOG("Object temperature measured value: %.4f", MLX_T.object);
-            //LOG("Temp Object = %3.2f",MLX_T.object);
-        }
+        mlx90632_calc_temp_kernel(&MLX_T_RAW, &MLX_T);
+        LOG("Ambient temperature measured value: %.4f", MLX_T.ambient);
+        LOG("Object temperature measured value: %.4f", MLX_T.object);
     }
 }
 
@@ -618,22 +1050,41 @@ uint16_t mlx90632_getTempObj(){
 }
 
 
-void mlx90632_searchWaitTime(int meas_ret){
+void mlx90632_checkTimeout(int meas_ret){
     if ( meas_ret == - ETIMEDOUT){
         MLX_STS.count_check_meas ++;
-         if ( MLX_STS.count_check_meas >= MLX90632_MAX_NUM_CHECK_MEAS){
-            MLX_STS.wait_time_meas = MLX_STS.wait_time_meas + MLX90632_STEP_WAIT_TIME;
+        if ( MLX_STS.count_check_meas >= MLX90632_MAX_NUM_CHECK_MEAS){
+            LOG("Measurement timeout %d times, reset sensor", MLX_STS.count_check_meas);
             mlx90632_addressed_reset();
-            if (MLX_STS.wait_time_meas == MLX90632_MAX_WAIT_TIME)MLX_STS.wait_time_meas = MLX90632_STEP_WAIT_TIME;
-         }
+            MLX_STS.count_check_meas = 0;
+        }
     }else{
          MLX_STS.count_check_meas = 0;
     }
 }
 
+uint32_t mlx90632_calc_conv_time(mlx90632_meas_t refresh){
+    if ((refresh < MLX90632_MEAS_HZ_HALF) || (refresh > MLX90632_MEAS_HZ_64))
+        return MLX90632_MEAS_MAX_TIME * 1000U;
+
+    return (MLX90632_MEAS_MAX_TIME * 1000U) >> refresh;
+}
+
+void mlx90632_get_poll_stats(MLXPollStats_s *stats){
+    *stats = MLX_POLL;
+}
+
+void mlx90632_reset_poll_stats(void){
+    MLX_POLL.last = 0U;
+    MLX_POLL.max = 0U;
+    MLX_POLL.total = 0U;
+    MLX_POLL.samples = 0U;
+}
+
 
 void mlx90632_set_emissivity(double value){
     emissivity = value;
+    mlx90632_kernel_prepare();
 }
 
 double mlx90632_get_emissivity(void){
@@ -648,12 +1099,14 @@ double mlx90632_get_emissivity(void){
 }
 
 extern void usleep(int min_range, int max_range){
+    const MLXBus_s *bus = mlx90632_bus_get();
 
-    k_usleep(( min_range + max_range )  / 2);
+    bus->sleep_us(bus->ctx, (uint32_t)(( min_range + max_range )  / 2));
 }
 
 extern void msleep(int msecs){
+    const MLXBus_s *bus = mlx90632_bus_get();
 
-    k_sleep(K_MSEC(msecs));
+    bus->sleep_us(bus->ctx, (uint32_t)msecs * 1000U);
 }
 
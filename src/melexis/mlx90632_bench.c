@@ -0,0 +1,294 @@
+/******************************************************************************
+ * Copyright (c) 2025 Marconatale Parise.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * You may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************/
+/**
+ * @file mlx90632_bench.c
+ * @brief microbenchmark of the stages of mlx90632_read()
+ *
+ * Timed runs of a stage are stored in one shared buffer, sorted once the stage is done
+ * and reduced to min, mean, p99 and max in ns.
+ *
+ */
+#include "mlx90632_bench.h"
+#include "mlx90632_hal.h"
+#include "mlx90632_kernel.h"
+#include "mlx90632_filter.h"
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__ZEPHYR__) && defined(CONFIG_CPU_CORTEX_M_HAS_DWT)
+#include <zephyr/arch/arm/aarch32/cortex_m/cmsis.h>
+#endif
+
+#define MLX90632_BENCH_OVERHEAD_RUNS 32 /**< Empty runs to measure the timer overhead */
+
+static uint32_t bench_ticks[MLX90632_BENCH_MAX_SAMPLES];
+static uint32_t bench_overhead;
+static volatile double bench_sink;
+
+static const char *const bench_stage_names[MLX90632_BENCH_STAGES] = {
+    [MLX90632_BENCH_I2C] = "i2c",
+    [MLX90632_BENCH_POLL] = "poll",
+    [MLX90632_BENCH_DECODE] = "decode",
+    [MLX90632_BENCH_AMBIENT] = "ambient",
+    [MLX90632_BENCH_OBJECT] = "object",
+    [MLX90632_BENCH_EMA] = "ema",
+    [MLX90632_BENCH_MEDIAN] = "median",
+    [MLX90632_BENCH_KALMAN] = "kalman",
+    [MLX90632_BENCH_FORMAT] = "format",
+};
+
+#if defined(__ZEPHYR__) && defined(CONFIG_CPU_CORTEX_M_HAS_DWT)
+static bool bench_dwt;
+#endif
+
+/* Start the timer and return its frequency */
+static uint32_t mlx90632_bench_timer_init(void){
+#ifdef __ZEPHYR__
+#ifdef CONFIG_CPU_CORTEX_M_HAS_DWT
+    uint32_t start;
+
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+    //the counter may be missing or not accessible (e.g. non-secure image), fall back on the kernel cycles
+    start = DWT->CYCCNT;
+    k_busy_wait(1);
+    bench_dwt = (DWT->CYCCNT != start);
+    if (bench_dwt)
+        return SystemCoreClock;
+#endif
+    return (uint32_t)sys_clock_hw_cycles_per_sec();
+#else
+    return 1000000000U;
+#endif
+}
+
+static inline uint32_t mlx90632_bench_timer_now(void){
+#ifdef __ZEPHYR__
+#ifdef CONFIG_CPU_CORTEX_M_HAS_DWT
+    if (bench_dwt)
+        return DWT->CYCCNT;
+#endif
+    return k_cycle_get_32();
+#else
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t)((uint64_t)ts.tv_sec * 1000000000U + (uint64_t)ts.tv_nsec);
+#endif
+}
+
+static int mlx90632_bench_cmp(const void *a, const void *b){
+    uint32_t x = *(const uint32_t *)a;
+    uint32_t y = *(const uint32_t *)b;
+
+    return (x > y) - (x < y);
+}
+
+static uint32_t mlx90632_bench_to_ns(uint64_t ticks, uint32_t hz){
+    return (uint32_t)(ticks * 1000000000U / hz);
+}
+
+/* Minimum cost of reading the timer twice, subtracted from every run */
+static uint32_t mlx90632_bench_overhead(void){
+    uint32_t i, t0, ticks, best = UINT32_MAX;
+
+    for (i = 0; i < MLX90632_BENCH_OVERHEAD_RUNS; i++){
+        t0 = mlx90632_bench_timer_now();
+        ticks = mlx90632_bench_timer_now() - t0;
+        best = MIN(best, ticks);
+    }
+    return best;
+}
+
+/* Sort the n timed runs of a stage and reduce them */
+static void mlx90632_bench_reduce(uint32_t n, uint32_t hz, MLXBenchStage_s *stage){
+    uint64_t total = 0;
+    uint32_t i;
+
+    stage->samples = n;
+    if (n == 0)
+        return;
+
+    for (i = 0; i < n; i++)
+        bench_ticks[i] = (bench_ticks[i] > bench_overhead) ? bench_ticks[i] - bench_overhead : 0;
+    qsort(bench_ticks, n, sizeof(bench_ticks[0]), mlx90632_bench_cmp);
+    for (i = 0; i < n; i++)
+        total += bench_ticks[i];
+
+    stage->min_ns = mlx90632_bench_to_ns(bench_ticks[0], hz);
+    stage->mean_ns = mlx90632_bench_to_ns(total / n, hz);
+    stage->p99_ns = mlx90632_bench_to_ns(bench_ticks[(n * 99U + 99U) / 100U - 1U], hz);
+    stage->max_ns = mlx90632_bench_to_ns(bench_ticks[n - 1], hz);
+}
+
+static double mlx90632_bench_ambient(const MLXTempRaw_s *raw){
+#if MLX_KERNEL == MLX_KERNEL_FLOAT
+    return mlx90632_calc_temp_ambient_f(raw, &MLX_KP);
+#elif MLX_KERNEL == MLX_KERNEL_FIXED
+    return mlx90632_calc_temp_ambient_q(raw, &MLX_KP);
+#else
+    return mlx90632_calc_temp_ambient_d(raw, &MLX_KP);
+#endif
+}
+
+static double mlx90632_bench_object(const MLXTempRaw_s *raw, MLXSolver_s *solver){
+#if MLX_SOLVER == MLX_SOLVER_WARM
+    MLXTemp_s temp;
+
+    mlx90632_calc_temp_warm(raw, &MLX_KP, solver, &temp);
+    return temp.object;
+#elif MLX_KERNEL == MLX_KERNEL_FLOAT
+    return mlx90632_calc_temp_object_f(raw, &MLX_KP);
+#elif MLX_KERNEL == MLX_KERNEL_FIXED
+    return mlx90632_calc_temp_object_q(raw, &MLX_KP);
+#else
+    return mlx90632_calc_temp_object_d(raw, &MLX_KP);
+#endif
+}
+
+/* One filter stage, the input moves by a few noise steps so the median sort does real work */
+static void mlx90632_bench_filter(uint32_t iterations, uint32_t hz, mlx90632_filter_t type,
+                                  const MLXTemp_s *temp, MLXBenchStage_s *stage){
+    const MLXFilterConfig_s cfg = {
+        .type = type,
+        .ema_alpha = MLX90632_FILTER_EMA_ALPHA,
+        .median_len = MLX90632_FILTER_MEDIAN_LEN,
+        .kalman_q = MLX90632_FILTER_KALMAN_Q,
+        .kalman_r = MLX90632_FILTER_KALMAN_R,
+    };
+    MLXFilter_s filter;
+    MLXTemp_s in;
+    uint32_t i, t0;
+
+    mlx90632_filter_init(&filter, &cfg);
+    for (i = 0; i < iterations; i++){
+        in.ambient = temp->ambient + (double)(i % 7U) * 0.01;
+        in.object = temp->object - (double)(i % 5U) * 0.01;
+        t0 = mlx90632_bench_timer_now();
+        mlx90632_filter_apply(&filter, &in);
+        bench_ticks[i] = mlx90632_bench_timer_now() - t0;
+        bench_sink = in.object;
+    }
+    mlx90632_bench_reduce(iterations, hz, stage);
+}
+
+int32_t mlx90632_bench_run(uint32_t iterations, MLXBench_s *bench){
+    uint16_t ram[MLX90632_RAM_BLOCK_LEN];
+    uint16_t reg_status;
+    MLXTempRaw_s raw;
+    MLXTemp_s temp;
+    MLXSolver_s solver;
+    char line[64];
+    uint32_t i, n, t0, hz;
+    int cycle_pos = 1;
+
+    memset(bench, 0, sizeof(*bench));
+    iterations = MIN(iterations, MLX90632_BENCH_MAX_SAMPLES);
+    hz = mlx90632_bench_timer_init();
+    bench_overhead = mlx90632_bench_overhead();
+    bench->timer_hz = hz;
+    bench->overhead_ns = mlx90632_bench_to_ns(bench_overhead, hz);
+
+    for (i = 0, n = 0; i < iterations; i++){
+        t0 = mlx90632_bench_timer_now();
+        if (mlx90632_i2c_read_block(MLX90632_RAM_BLOCK_START, ram, MLX90632_RAM_BLOCK_LEN) < 0){
+            bench->stage[MLX90632_BENCH_I2C].errors++;
+            continue;
+        }
+        bench_ticks[n++] = mlx90632_bench_timer_now() - t0;
+    }
+    mlx90632_bench_reduce(n, hz, &bench->stage[MLX90632_BENCH_I2C]);
+    if (n == 0)
+        return -EIO;
+
+    for (i = 0, n = 0; i < iterations; i++){
+        t0 = mlx90632_bench_timer_now();
+        if (mlx90632_i2c_read(MLX90632_REG_STATUS, &reg_status) < 0){
+            bench->stage[MLX90632_BENCH_POLL].errors++;
+            continue;
+        }
+        if (reg_status & MLX90632_STAT_DATA_RDY)
+            cycle_pos = (int)(reg_status & (uint16_t)MLX90632_STAT_CYCLE_POS) >> 2;
+        bench_ticks[n++] = mlx90632_bench_timer_now() - t0;
+    }
+    mlx90632_bench_reduce(n, hz, &bench->stage[MLX90632_BENCH_POLL]);
+
+    //the sensor may be idle, decode as cycle position 1 or 2 only
+    if ((cycle_pos != 1) && (cycle_pos != 2))
+        cycle_pos = 1;
+
+    for (i = 0; i < iterations; i++){
+        t0 = mlx90632_bench_timer_now();
+        mlx90632_decodeTempRaw(cycle_pos, ram, &raw);
+        bench_ticks[i] = mlx90632_bench_timer_now() - t0;
+    }
+    mlx90632_bench_reduce(iterations, hz, &bench->stage[MLX90632_BENCH_DECODE]);
+
+    for (i = 0; i < iterations; i++){
+        t0 = mlx90632_bench_timer_now();
+        bench_sink = mlx90632_bench_ambient(&raw);
+        bench_ticks[i] = mlx90632_bench_timer_now() - t0;
+    }
+    mlx90632_bench_reduce(iterations, hz, &bench->stage[MLX90632_BENCH_AMBIENT]);
+    temp.ambient = bench_sink;
+
+    //warm solver: the first run is cold, the next ones are warm as in continuous acquisition
+    mlx90632_solver_init(&solver, MLX_SOLVER_TOLERANCE, MLX90632_SOLVER_MAX_ITER);
+    for (i = 0; i < iterations; i++){
+        t0 = mlx90632_bench_timer_now();
+        bench_sink = mlx90632_bench_object(&raw, &solver);
+        bench_ticks[i] = mlx90632_bench_timer_now() - t0;
+    }
+    mlx90632_bench_reduce(iterations, hz, &bench->stage[MLX90632_BENCH_OBJECT]);
+    temp.object = bench_sink;
+
+    mlx90632_bench_filter(iterations, hz, MLX90632_FILTER_EMA, &temp, &bench->stage[MLX90632_BENCH_EMA]);
+    mlx90632_bench_filter(iterations, hz, MLX90632_FILTER_MEDIAN, &temp, &bench->stage[MLX90632_BENCH_MEDIAN]);
+    mlx90632_bench_filter(iterations, hz, MLX90632_FILTER_KALMAN, &temp, &bench->stage[MLX90632_BENCH_KALMAN]);
+
+    for (i = 0; i < iterations; i++){
+        t0 = mlx90632_bench_timer_now();
+        snprintf(line, sizeof(line), "Ambient temperature measured value: %.4f", temp.ambient);
+        snprintf(line, sizeof(line), "Object temperature measured value: %.4f", temp.object);
+        bench_ticks[i] = mlx90632_bench_timer_now() - t0;
+    }
+    mlx90632_bench_reduce(iterations, hz, &bench->stage[MLX90632_BENCH_FORMAT]);
+
+    return 0;
+}
+
+void mlx90632_bench_print(const MLXBench_s *bench){
+    const MLXBenchStage_s *stage;
+    int i;
+
+    printk("mlx90632 bench, timer %u Hz (overhead %u ns removed), kernel %d, solver %d\n",
+           bench->timer_hz, bench->overhead_ns, MLX_KERNEL, MLX_SOLVER);
+    printk("%-8s %8s %8s %10s %10s %10s %10s\n", "stage", "samples", "errors", "min ns", "mean ns", "p99 ns", "max ns");
+    for (i = 0; i < MLX90632_BENCH_STAGES; i++){
+        stage = &bench->stage[i];
+        printk("%-8s %8u %8u %10u %10u %10u %10u\n", bench_stage_names[i], stage->samples, stage->errors,
+               stage->min_ns, stage->mean_ns, stage->p99_ns, stage->max_ns);
+    }
+}
+
+const char *mlx90632_bench_stage_name(mlx90632_bench_stage_t stage){
+    if ((unsigned)stage >= MLX90632_BENCH_STAGES)
+        return "?";
+    return bench_stage_names[stage];
+}
@@ -0,0 +1,156 @@
+/******************************************************************************
+ * Copyright (c) 2025 Marconatale Parise.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * You may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************/
+/**
+ * @file mlx90632_bus_linux.c
+ * @brief Linux backend of the melexis bus interface
+ *
+ * This implementation file provides register access through the i2c-dev interface
+ * (ioctl I2C_RDWR with repeated start), sleeping through nanosleep() and timestamps
+ * through clock_gettime(CLOCK_MONOTONIC).
+ *
+ * Until mlx90632_bus_linux_open() succeeds every register access fails with -ENODEV, while
+ * sleep and time are always available.
+ *
+ */
+#define _POSIX_C_SOURCE 200809L
+
+#include <errno.h>
+#include <fcntl.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <linux/i2c.h>
+#include <linux/i2c-dev.h>
+#include "mlx90632_bus.h"
+
+typedef struct{
+    int fd;
+    uint16_t addr;
+}MLXBusLinux_s;
+
+static MLXBusLinux_s mlx90632_bus_linux_ctx = {.fd = -1, .addr = MLX90632_I2C_ADDR};
+
+int32_t mlx90632_bus_linux_open(const char *path, uint16_t addr){
+    int fd;
+
+    mlx90632_bus_linux_close();
+
+    fd = open(path, O_RDWR);
+    if (fd < 0)
+        return -errno;
+
+    mlx90632_bus_linux_ctx.fd = fd;
+    mlx90632_bus_linux_ctx.addr = addr;
+    return 0;
+}
+
+void mlx90632_bus_linux_close(void){
+    if (mlx90632_bus_linux_ctx.fd >= 0)
+        close(mlx90632_bus_linux_ctx.fd);
+    mlx90632_bus_linux_ctx.fd = -1;
+}
+
+static int32_t mlx90632_bus_linux_read_block(void *ctx, uint16_t reg, uint16_t *value, uint16_t len){
+    MLXBusLinux_s *bus = ctx;
+    uint8_t reg_write[2];
+    struct i2c_msg msg[2];
+    struct i2c_rdwr_ioctl_data xfer;
+    uint16_t i;
+
+    if (bus->fd < 0)
+        return -ENODEV;
+
+    reg_write[0] = (reg >> 8); //MSB
+    reg_write[1] = (reg & 0xFF); //LSB
+
+    msg[0].addr = bus->addr;
+    msg[0].flags = 0;
+    msg[0].len = sizeof(reg_write);
+    msg[0].buf = reg_write;
+
+    msg[1].addr = bus->addr;
+    msg[1].flags = I2C_M_RD;
+    msg[1].len = (uint16_t)(len * 2);
+    msg[1].buf = (uint8_t *)value;
+
+    xfer.msgs = msg;
+    xfer.nmsgs = 2;
+
+    if (ioctl(bus->fd, I2C_RDWR, &xfer) < 0)
+        return -errno;
+
+    //sensor sends MSB first for each word
+    for (i = 0; i < len; i++)
+        value[i] = (value[i] >> 8) | ((value[i] & 0x00FF) << 8);
+    return 0;
+}
+
+static int32_t mlx90632_bus_linux_read(void *ctx, uint16_t reg, uint16_t *value){
+    return mlx90632_bus_linux_read_block(ctx, reg, value, 1);
+}
+
+static int32_t mlx90632_bus_linux_write(void *ctx, uint16_t reg, uint16_t value){
+    MLXBusLinux_s *bus = ctx;
+    uint8_t frame[4];
+    struct i2c_msg msg;
+    struct i2c_rdwr_ioctl_data xfer;
+
+    if (bus->fd < 0)
+        return -ENODEV;
+
+    frame[0] = (reg >> 8); //MSB
+    frame[1] = (reg & 0xFF); //LSB
+    frame[2] = (value >> 8); //MSB
+    frame[3] = (value & 0xFF); //LSB
+
+    msg.addr = bus->addr;
+    msg.flags = 0;
+    msg.len = sizeof(frame);
+    msg.buf = frame;
+
+    xfer.msgs = &msg;
+    xfer.nmsgs = 1;
+
+    if (ioctl(bus->fd, I2C_RDWR, &xfer) < 0)
+        return -errno;
+    return 0;
+}
+
+static void mlx90632_bus_linux_sleep_us(void *ctx, uint32_t us){
+    struct timespec ts;
+
+    ts.tv_sec = us / 1000000U;
+    ts.tv_nsec = (long)(us % 1000000U) * 1000L;
+    while (nanosleep(&ts, &ts) < 0 && errno == EINTR)
+        ;
+}
+
+static uint64_t mlx90632_bus_linux_now_us(void *ctx){
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000U + (uint64_t)ts.tv_nsec / 1000U;
+}
+
+const MLXBus_s mlx90632_bus_linux = {
+    .read = mlx90632_bus_linux_read,
+    .write = mlx90632_bus_linux_write,
+    .read_block = mlx90632_bus_linux_read_block,
+    .sleep_us = mlx90632_bus_linux_sleep_us,
+    .now_us = mlx90632_bus_linux_now_us,
+    .ctx = &mlx90632_bus_linux_ctx,
+};
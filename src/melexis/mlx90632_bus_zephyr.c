@@ -0,0 +1,103 @@
+/******************************************************************************
+ * Copyright (c) 2025 Marconatale Parise.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * You may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************/
+/**
+ * @file mlx90632_bus_zephyr.c
+ * @brief Zephyr backend of the melexis bus interface
+ *
+ * This implementation file provides register access through i2c_transfer() on I2C_DEV,
+ * sleeping through k_usleep() and timestamps through k_uptime_ticks().
+ * Error codes of the i2c driver are returned unchanged, so that NACKs and timeouts can be told apart.
+ *
+ */
+#include <zephyr/kernel.h>
+#include <zephyr/device.h>
+#include <zephyr/drivers/i2c.h>
+#include "i2c_dt.h"
+#include "mlx90632_bus.h"
+
+static int32_t mlx90632_bus_zephyr_read_block(void *ctx, uint16_t reg, uint16_t *value, uint16_t len){
+    uint8_t reg_write[2];
+    struct i2c_msg msg[2];
+    uint16_t i;
+    int ret;
+
+    reg_write[0] = (reg >> 8); //MSB
+    reg_write[1] = (reg & 0xFF); //LSB
+
+    msg[0].buf = reg_write;
+    msg[0].len = sizeof(reg_write);
+    msg[0].flags = I2C_MSG_WRITE;
+
+    msg[1].buf = (uint8_t *)value;
+    msg[1].len = (uint32_t)len * 2;
+    msg[1].flags = I2C_MSG_RESTART | I2C_MSG_READ | I2C_MSG_STOP;
+
+    ret = i2c_transfer(I2C_DEV, msg, 2, MLX90632_I2C_ADDR);
+    if (ret)
+        return ret;
+
+    //sensor sends MSB first for each word
+    for (i = 0; i < len; i++)
+        value[i] = (value[i] >> 8) | ((value[i] & 0x00FF) << 8);
+    return 0;
+}
+
+static int32_t mlx90632_bus_zephyr_read(void *ctx, uint16_t reg, uint16_t *value){
+    return mlx90632_bus_zephyr_read_block(ctx, reg, value, 1);
+}
+
+static int32_t mlx90632_bus_zephyr_write(void *ctx, uint16_t reg, uint16_t value){
+    uint8_t reg_write[2];
+    uint8_t data[2];
+    struct i2c_msg msg[2];
+    int ret;
+
+    reg_write[0] = (reg >> 8); //MSB
+    reg_write[1] = (reg & 0xFF); //LSB
+    data[0] = (value >> 8); //MSB
+    data[1] = (value & 0xFF); //LSB
+
+    msg[0].buf = reg_write;
+    msg[0].len = sizeof(reg_write);
+    msg[0].flags = I2C_MSG_WRITE;
+
+    msg[1].buf = data;
+    msg[1].len = sizeof(data);
+    msg[1].flags = I2C_MSG_WRITE | I2C_MSG_STOP;
+
+    ret = i2c_transfer(I2C_DEV, msg, 2, MLX90632_I2C_ADDR);
+    if (ret)
+        return ret;
+    return 0;
+}
+
+static void mlx90632_bus_zephyr_sleep_us(void *ctx, uint32_t us){
+    k_usleep((int32_t)us);
+}
+
+static uint64_t mlx90632_bus_zephyr_now_us(void *ctx){
+    return k_ticks_to_us_floor64(k_uptime_ticks());
+}
+
+const MLXBus_s mlx90632_bus_zephyr = {
+    .read = mlx90632_bus_zephyr_read,
+    .write = mlx90632_bus_zephyr_write,
+    .read_block = mlx90632_bus_zephyr_read_block,
+    .sleep_us = mlx90632_bus_zephyr_sleep_us,
+    .now_us = mlx90632_bus_zephyr_now_us,
+    .ctx = NULL,
+};
@@ -0,0 +1,227 @@
+/******************************************************************************
+ * Copyright (c) 2025 Marconatale Parise.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * You may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************/
+/**
+ * @file mlx90632_cache.c
+ * @brief Melexis calibration cache stored in flash
+ *
+ * This implementation file keeps decoded melexis calibration in Zephyr settings so that warm
+ * boots and i2c recoveries skip the eeprom calibration reads.
+ * 
+ * @author Marconatale Parise
+ * @date 09 June 2025
+ *
+ */
+#include "mlx90632_cache.h"
+
+#if defined(CONFIG_SETTINGS)
+
+#include <stdlib.h>
+#include <string.h>
+#include <zephyr/settings/settings.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/sys/crc.h>
+
+LOG_MODULE_DECLARE(mlx90632, CONFIG_MLX90632_LOG_LEVEL);
+
+/* record and fingerprint of one sensor */
+typedef struct{
+    uint16_t id;
+    bool used;
+    bool cache_valid;           /**< cache holds the record stored in flash */
+    bool fp_valid;              /**< fingerprint read by last mlx90632_cache_load() */
+    uint16_t fp_version;
+    uint16_t fp_crc;
+    MLXCalibCache_s cache;
+}MLXCalibCacheSlot_s;
+
+static MLXCalibCacheSlot_s slots[MLX90632_CACHE_SLOTS];
+static bool cache_loaded = false;
+
+static MLXCalibCacheSlot_s *mlx90632_cache_slot(uint16_t id, bool create){
+    size_t i;
+
+    for (i = 0; i < ARRAY_SIZE(slots); i++){
+        if (slots[i].used && (slots[i].id == id))
+            return &slots[i];
+    }
+    if (!create)
+        return NULL;
+
+    for (i = 0; i < ARRAY_SIZE(slots); i++){
+        if (!slots[i].used){
+            memset(&slots[i], 0, sizeof(slots[i]));
+            slots[i].used = true;
+            slots[i].id = id;
+            return &slots[i];
+        }
+    }
+    return NULL;
+}
+
+static void mlx90632_cache_key(uint16_t id, char *key, size_t len){
+    snprintk(key, len, MLX90632_CACHE_KEY "/%x", id);
+}
+
+static int mlx90632_cache_set(const char *key, size_t len, settings_read_cb read_cb, void *cb_arg){
+    MLXCalibCacheSlot_s *slot;
+    const char *next;
+    char *end;
+    unsigned long id;
+    ssize_t rc;
+
+    //"calib/<id>", the record of one sensor
+    if (!settings_name_steq(key, "calib", &next) || !next)
+        return -ENOENT;
+
+    id = strtoul(next, &end, 16);
+    if ((end == next) || (*end != '\0') || (id > UINT16_MAX))
+        return -ENOENT;
+    if (len != sizeof(slot->cache))
+        return -EINVAL;
+
+    slot = mlx90632_cache_slot((uint16_t)id, true);
+    if (slot == NULL)
+        return -ENOMEM;
+
+    rc = read_cb(cb_arg, &slot->cache, sizeof(slot->cache));
+    if (rc < 0){
+        slot->cache_valid = false;
+        return (int)rc;
+    }
+
+    slot->cache_valid = true;
+    return 0;
+}
+
+SETTINGS_STATIC_HANDLER_DEFINE(mlx90632, "mlx90632", NULL, mlx90632_cache_set, NULL, NULL);
+
+static int32_t mlx90632_cache_settings_load(void){
+    int rc;
+
+    if (cache_loaded)
+        return 0;
+
+    rc = settings_subsys_init();
+    if (rc < 0){
+        LOG("Calibration cache: settings init failed with error code %d", rc);
+        return rc;
+    }
+
+    rc = settings_load_subtree("mlx90632");
+    if (rc < 0)
+        return rc;
+
+    cache_loaded = true;
+    return 0;
+}
+
+int32_t mlx90632_cache_load(uint16_t id, MLXCalib_s *calib){
+    MLXCalibCacheSlot_s *slot;
+    int32_t ret;
+    uint16_t fp[MLX90632_EE_FINGERPRINT_LEN];
+
+    ret = mlx90632_cache_settings_load();
+    if (ret < 0)
+        return ret;
+
+    slot = mlx90632_cache_slot(id, true);
+    if (slot == NULL)
+        return -ENOMEM;
+    slot->fp_valid = false;
+
+    ret = mlx90632_i2c_read_block(MLX90632_EE_FINGERPRINT_START, fp, MLX90632_EE_FINGERPRINT_LEN);
+    if (ret < 0)
+        return ret;
+
+    slot->fp_version = fp[MLX90632_EE_VERSION - MLX90632_EE_FINGERPRINT_START];
+    slot->fp_crc = crc16_ccitt(MLX90632_EE_SEED, (const uint8_t *)fp, sizeof(fp));
+    slot->fp_valid = true;
+
+    if (!slot->cache_valid || (slot->cache.ee_version != slot->fp_version) || (slot->cache.fp_crc != slot->fp_crc))
+        return -ENOENT;
+
+    *calib = slot->cache.calib;
+    LOG("Calibration of 0x%02x loaded from cache (crc 0x%04X)", id, slot->cache.ee_crc);
+    return 0;
+}
+
+int32_t mlx90632_cache_store(uint16_t id, const MLXEeprom_s *ee, const MLXCalib_s *calib){
+    MLXCalibCacheSlot_s *slot = mlx90632_cache_slot(id, false);
+    char key[sizeof(MLX90632_CACHE_KEY "/ffff")];
+    int rc;
+    uint16_t ee_crc;
+
+    if ((slot == NULL) || !slot->fp_valid)
+        return -EINVAL;
+
+    ee_crc = crc16_ccitt(MLX90632_EE_SEED, (const uint8_t *)ee, sizeof(*ee));
+
+    //avoid flash wear when nothing changed
+    if (slot->cache_valid && (slot->cache.ee_version == slot->fp_version) &&
+        (slot->cache.fp_crc == slot->fp_crc) && (slot->cache.ee_crc == ee_crc))
+        return 0;
+
+    slot->cache.ee_version = slot->fp_version;
+    slot->cache.fp_crc = slot->fp_crc;
+    slot->cache.ee_crc = ee_crc;
+    slot->cache.calib = *calib;
+
+    mlx90632_cache_key(id, key, sizeof(key));
+    rc = settings_save_one(key, &slot->cache, sizeof(slot->cache));
+    if (rc < 0){
+        LOG("Calibration cache: store failed with error code %d", rc);
+        slot->cache_valid = false;
+        return rc;
+    }
+
+    slot->cache_valid = true;
+    return 0;
+}
+
+int32_t mlx90632_cache_invalidate(uint16_t id){
+    MLXCalibCacheSlot_s *slot = mlx90632_cache_slot(id, false);
+    char key[sizeof(MLX90632_CACHE_KEY "/ffff")];
+
+    if (slot != NULL)
+        slot->cache_valid = false;
+
+    mlx90632_cache_key(id, key, sizeof(key));
+    return settings_delete(key);
+}
+
+#ifdef TEST
+void mlx90632_cache_reset(void){
+    memset(slots, 0, sizeof(slots));
+    cache_loaded = false;
+}
+#endif
+
+#else
+
+int32_t mlx90632_cache_load(uint16_t id, MLXCalib_s *calib){
+    return -ENOENT;
+}
+
+int32_t mlx90632_cache_store(uint16_t id, const MLXEeprom_s *ee, const MLXCalib_s *calib){
+    return 0;
+}
+
+int32_t mlx90632_cache_invalidate(uint16_t id){
+    return 0;
+}
+
+#endif
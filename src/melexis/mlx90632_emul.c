@@ -0,0 +1,442 @@
+/******************************************************************************
+ * Copyright (c) 2025 Marconatale Parise.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * You may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************/
+/**
+ * @file mlx90632_emul.c
+ * @brief I2C emulator of the melexis sensor
+ *
+ * This implementation file provides a register level model of the MLX90632 on the Zephyr
+ * i2c emulation controller. The state is advanced lazily on each transfer from the uptime, so
+ * no timer or thread is needed.
+ *
+ */
+#define DT_DRV_COMPAT melexis_mlx90632
+
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/device.h>
+#include <zephyr/drivers/emul.h>
+#include <zephyr/drivers/i2c.h>
+#include <zephyr/drivers/i2c_emul.h>
+#include "mlx90632.h"
+#include "mlx90632_emul.h"
+
+#define MLX90632_EMUL_EE_START      0x2400 /**< First emulated EEPROM word */
+#define MLX90632_EMUL_EE_LEN        0x100 /**< Emulated EEPROM words */
+#define MLX90632_EMUL_RAM_LEN       (3 * MLX90632_MAX_MEAS_NUM) /**< Emulated RAM words */
+#define MLX90632_EMUL_CMD           0x3005 /**< Command register: EEPROM unlock key and reset */
+#define MLX90632_EMUL_EE_WRITE_US   10000U /**< EEPROM busy time after a write */
+#define MLX90632_EMUL_RAM9          30000 /**< Reference channel RAM_9, fixed */
+#define MLX90632_EMUL_EE_MEAS1      0x820D /**< Default medical measurement 1, refresh rate 2 */
+#define MLX90632_EMUL_EE_MEAS2      0x82D2 /**< Default medical measurement 2, refresh rate 2 */
+#define MLX90632_EMUL_EE_CTRL       MLX90632_PWR_STATUS_CONTINUOUS /**< Power on in continuous mode */
+
+#define MLX90632_EMUL_EE(addr)      (data->eeprom[(addr) - MLX90632_EMUL_EE_START])
+
+struct mlx90632_emul_data {
+    uint16_t eeprom[MLX90632_EMUL_EE_LEN];
+    uint16_t ram[MLX90632_EMUL_RAM_LEN];
+    uint16_t ctrl;
+    uint16_t status;
+    bool unlocked;              /**< next EEPROM write accepted */
+    uint64_t ee_busy_until_us;
+    uint64_t t0_us;             /**< init time, origin of the profile */
+    bool measuring;             /**< step mode measurement ongoing */
+    uint8_t positions_left;     /**< cycle positions left in the step measurement */
+    uint8_t next_pos;           /**< cycle position being measured */
+    uint64_t next_ready_us;     /**< completion time of next_pos */
+    uint64_t ready_us;          /**< completion time of the last position */
+    bool ready_pending;         /**< last position not read yet, for latency */
+    bool nack;
+    MLXEmulProfile_t profile;
+    MLXEmulStats_s stats;
+};
+
+struct mlx90632_emul_cfg {
+    uint16_t addr;
+};
+
+/* Eeprom image of a medical sensor, 32-bit constants are stored low word first */
+static const struct {
+    uint16_t addr;
+    int32_t value;
+    uint8_t width;
+} mlx90632_emul_calib[] = {
+    { MLX90632_EE_P_R, 0x00587f5b, 32 },
+    { MLX90632_EE_P_G, 0x04a10289, 32 },
+    { MLX90632_EE_P_T, (int32_t)0xfff966f8, 32 },
+    { MLX90632_EE_P_O, 0x00001e0f, 32 },
+    { MLX90632_EE_Ea, 4859535, 32 },
+    { MLX90632_EE_Eb, 5686508, 32 },
+    { MLX90632_EE_Fa, 53855361, 32 },
+    { MLX90632_EE_Fb, 42874149, 32 },
+    { MLX90632_EE_Ga, -14556410, 32 },
+    { MLX90632_EE_Gb, 9728, 16 },
+    { MLX90632_EE_Ka, 10752, 16 },
+    { MLX90632_EE_Ha, 16384, 16 },
+    { MLX90632_EE_Hb, 0, 16 },
+};
+
+static uint64_t mlx90632_emul_now_us(void){
+    return k_ticks_to_us_floor64(k_uptime_ticks());
+}
+
+static int16_t mlx90632_emul_sat16(double value){
+    if (value > INT16_MAX)
+        return INT16_MAX;
+    if (value < INT16_MIN)
+        return INT16_MIN;
+    return (int16_t)lround(value);
+}
+
+static void mlx90632_emul_default_profile(uint64_t t_us, double *ambient, double *object){
+    *ambient = 25.0;
+    *object = 36.6 + 2.0 * sin(2.0 * M_PI * (double)t_us / 60e6);
+}
+
+static double mlx90632_emul_ee32(struct mlx90632_emul_data *data, uint16_t addr, int shift){
+    int32_t raw = (int32_t)((uint32_t)MLX90632_EMUL_EE(addr) | ((uint32_t)MLX90632_EMUL_EE(addr + 1) << 16));
+
+    return ldexp((double)raw, -shift);
+}
+
+static double mlx90632_emul_ee16(struct mlx90632_emul_data *data, uint16_t addr, int shift){
+    return ldexp((double)(int16_t)MLX90632_EMUL_EE(addr), -shift);
+}
+
+static uint32_t mlx90632_emul_conv_us(struct mlx90632_emul_data *data){
+    return (MLX90632_MEAS_MAX_TIME * 1000U) >> MLX90632_REFRESH_RATE(MLX90632_EMUL_EE(MLX90632_EE_MEDICAL_MEAS1));
+}
+
+/* Invert the ambient and object formulas: temperatures to RAM_6, RAM_9 and object channel */
+static void mlx90632_emul_raw(struct mlx90632_emul_data *data, double ta, double to,
+                              int16_t *ram6, int16_t *ram9, int16_t *obj){
+    double P_R = mlx90632_emul_ee32(data, MLX90632_EE_P_R, 8);
+    double P_G = mlx90632_emul_ee32(data, MLX90632_EE_P_G, 20);
+    double P_T = mlx90632_emul_ee32(data, MLX90632_EE_P_T, 44);
+    double P_O = mlx90632_emul_ee32(data, MLX90632_EE_P_O, 8);
+    double Ea = mlx90632_emul_ee32(data, MLX90632_EE_Ea, 16);
+    double Eb = mlx90632_emul_ee32(data, MLX90632_EE_Eb, 8);
+    double Fa = mlx90632_emul_ee32(data, MLX90632_EE_Fa, 46);
+    double Fb = mlx90632_emul_ee32(data, MLX90632_EE_Fb, 36);
+    double Ga = mlx90632_emul_ee32(data, MLX90632_EE_Ga, 36);
+    double Gb = mlx90632_emul_ee16(data, MLX90632_EE_Gb, 10);
+    double Ka = mlx90632_emul_ee16(data, MLX90632_EE_Ka, 10);
+    double Ha = mlx90632_emul_ee16(data, MLX90632_EE_Ha, 14);
+    double Hb = mlx90632_emul_ee16(data, MLX90632_EE_Hb, 14);
+    double b, c, d, AMB, r6, r9, TAdut, TAk4, TOk, Sto, S;
+
+    //P_T * d^2 + d / P_G + (P_O - ta) = 0, root closest to the linear solution
+    b = 1.0 / P_G;
+    c = P_O - ta;
+    d = -2.0 * c / (b + sqrt(b * b - 4.0 * P_T * c));
+    AMB = d + P_R;
+
+    r9 = MLX90632_EMUL_RAM9;
+    r6 = MLX90632_REF_3 * AMB * r9 / (524288.0 - AMB * Gb);
+
+    TAdut = (AMB - Eb) / Ea + 25.0;
+    TAk4 = pow(TAdut + 273.15, 4);
+    TOk = to + Hb + 273.15;
+    Sto = (TOk * TOk * TOk * TOk - TAk4) * Fa * Ha * (1.0 + Ga * (to - 25.0) + Fb * (TAdut - 25.0));
+    S = Sto * MLX90632_REF_12 * (r9 + Ka * r6 / MLX90632_REF_3) / 524288.0;
+
+    *ram6 = mlx90632_emul_sat16(r6);
+    *ram9 = mlx90632_emul_sat16(r9);
+    *obj = mlx90632_emul_sat16(S);
+}
+
+/* Cycle position pos completed at t_us: latch RAM and flag data ready */
+static void mlx90632_emul_complete(struct mlx90632_emul_data *data, uint8_t pos, uint64_t t_us){
+    double ta, to;
+    int16_t ram6, ram9, obj;
+
+    data->profile(t_us - data->t0_us, &ta, &to);
+    mlx90632_emul_raw(data, ta, to, &ram6, &ram9, &obj);
+
+    data->ram[MLX90632_RAM_1(pos) - MLX90632_ADDR_RAM] = (uint16_t)obj;
+    data->ram[MLX90632_RAM_2(pos) - MLX90632_ADDR_RAM] = (uint16_t)obj;
+    data->ram[MLX90632_RAM_3(pos) - MLX90632_ADDR_RAM] = (uint16_t)((pos == 1) ? ram6 : ram9);
+
+    data->status &= ~(MLX90632_STAT_CYCLE_POS);
+    data->status |= (uint16_t)(pos << 2) | MLX90632_STAT_DATA_RDY;
+    data->next_pos = (pos == 1) ? 2 : 1;
+    data->ready_us = t_us;
+    data->ready_pending = true;
+    data->stats.samples++;
+}
+
+static void mlx90632_emul_update(struct mlx90632_emul_data *data, uint64_t now){
+    uint32_t conv = mlx90632_emul_conv_us(data);
+    uint64_t periods;
+
+    if (MLX90632_CFG_PWR(data->ctrl) == MLX90632_PWR_STATUS_CONTINUOUS){
+        if (now < data->next_ready_us)
+            return;
+        //only the last two positions matter when the host fell behind
+        periods = (now - data->next_ready_us) / conv;
+        if (periods > 2){
+            data->next_ready_us += (periods - 2) * conv;
+            if ((periods - 2) & 1)
+                data->next_pos = (data->next_pos == 1) ? 2 : 1;
+        }
+        while (now >= data->next_ready_us){
+            mlx90632_emul_complete(data, data->next_pos, data->next_ready_us);
+            data->next_ready_us += conv;
+        }
+        return;
+    }
+
+    while (data->measuring && (now >= data->next_ready_us)){
+        mlx90632_emul_complete(data, data->next_pos, data->next_ready_us);
+        if (--data->positions_left == 0){
+            data->measuring = false;
+            data->ctrl &= ~(MLX90632_CFG_SOC_MASK | MLX90632_CFG_SOB_MASK);
+        } else {
+            data->next_ready_us += conv;
+        }
+    }
+}
+
+static void mlx90632_emul_start(struct mlx90632_emul_data *data, uint8_t positions, uint64_t now){
+    data->measuring = true;
+    data->positions_left = positions;
+    if (positions > 1)
+        data->next_pos = 1;
+    data->next_ready_us = now + mlx90632_emul_conv_us(data);
+}
+
+static void mlx90632_emul_reset(struct mlx90632_emul_data *data, uint64_t now){
+    data->ctrl = MLX90632_EMUL_EE(MLX90632_EE_CTRL);
+    data->status = MLX90632_STAT_BRST;
+    data->measuring = false;
+    data->unlocked = false;
+    data->next_pos = 1;
+    data->next_ready_us = now + mlx90632_emul_conv_us(data);
+    //RAM_9 is the reference channel, constant in this model
+    data->ram[MLX90632_RAM_3(2) - MLX90632_ADDR_RAM] = MLX90632_EMUL_RAM9;
+}
+
+static uint16_t mlx90632_emul_reg_read(struct mlx90632_emul_data *data, uint16_t reg, uint64_t now){
+    uint16_t value;
+
+    if ((reg >= MLX90632_EMUL_EE_START) && (reg < MLX90632_EMUL_EE_START + MLX90632_EMUL_EE_LEN))
+        return MLX90632_EMUL_EE(reg);
+    if ((reg >= MLX90632_ADDR_RAM) && (reg < MLX90632_ADDR_RAM + MLX90632_EMUL_RAM_LEN))
+        return data->ram[reg - MLX90632_ADDR_RAM];
+
+    switch (reg){
+    case MLX90632_REG_I2C_ADDR:
+        return MLX90632_EMUL_EE(MLX90632_EE_I2C_ADDRESS);
+    case MLX90632_REG_CTRL:
+        return data->ctrl;
+    case MLX90632_REG_STATUS:
+        value = data->status;
+        if (data->measuring || (MLX90632_CFG_PWR(data->ctrl) == MLX90632_PWR_STATUS_CONTINUOUS))
+            value |= MLX90632_STAT_BUSY;
+        if (now < data->ee_busy_until_us)
+            value |= MLX90632_STAT_EE_BUSY;
+        return value;
+    default:
+        return 0;
+    }
+}
+
+static void mlx90632_emul_ee_write(struct mlx90632_emul_data *data, uint16_t reg, uint16_t value, uint64_t now){
+    if (!data->unlocked || (now < data->ee_busy_until_us))
+        return;
+
+    data->unlocked = false;
+    //0 erases the word, programming only sets bits of an erased word
+    if (value == 0)
+        MLX90632_EMUL_EE(reg) = 0;
+    else
+        MLX90632_EMUL_EE(reg) |= value;
+    data->ee_busy_until_us = now + MLX90632_EMUL_EE_WRITE_US;
+}
+
+static void mlx90632_emul_reg_write(struct mlx90632_emul_data *data, uint16_t reg, uint16_t value, uint64_t now){
+    uint16_t old_mode;
+
+    if ((reg >= MLX90632_EMUL_EE_START) && (reg < MLX90632_EMUL_EE_START + MLX90632_EMUL_EE_LEN)){
+        mlx90632_emul_ee_write(data, reg, value, now);
+        return;
+    }
+
+    switch (reg){
+    case MLX90632_REG_CTRL:
+        old_mode = MLX90632_CFG_PWR(data->ctrl);
+        data->ctrl = value & ~(MLX90632_CFG_SOC_MASK | MLX90632_CFG_SOB_MASK);
+        if (MLX90632_CFG_PWR(value) == MLX90632_PWR_STATUS_CONTINUOUS){
+            data->measuring = false;
+            if (old_mode != MLX90632_PWR_STATUS_CONTINUOUS){
+                data->next_pos = 1;
+                data->next_ready_us = now + mlx90632_emul_conv_us(data);
+            }
+        } else if (MLX90632_CFG_PWR(value) == MLX90632_PWR_STATUS_HALT){
+            data->measuring = false;
+        } else if (data->measuring){
+            //SOC/SOB stay set until the measurement completes
+            data->ctrl |= value & (MLX90632_CFG_SOC_MASK | MLX90632_CFG_SOB_MASK);
+        } else if (value & MLX90632_CFG_SOB_MASK){
+            mlx90632_emul_start(data, 2, now);
+            data->ctrl |= MLX90632_CFG_SOB_MASK;
+        } else if (value & MLX90632_CFG_SOC_MASK){
+            mlx90632_emul_start(data, 1, now);
+            data->ctrl |= MLX90632_CFG_SOC_MASK;
+        }
+        break;
+    case MLX90632_REG_STATUS:
+        //only data ready is writable, cleared by writing 0
+        if (!(value & MLX90632_STAT_DATA_RDY))
+            data->status &= ~MLX90632_STAT_DATA_RDY;
+        break;
+    case MLX90632_EMUL_CMD:
+        if (value == MLX90632_EEPROM_WRITE_KEY)
+            data->unlocked = true;
+        else if (value == MLX90632_RESET_CMD)
+            mlx90632_emul_reset(data, now);
+        break;
+    default:
+        break;
+    }
+}
+
+static int mlx90632_emul_transfer(const struct emul *target, struct i2c_msg *msgs, int num_msgs, int addr){
+    struct mlx90632_emul_data *data = target->data;
+    uint8_t wbuf[4];
+    uint16_t reg, value;
+    uint32_t latency;
+    size_t wlen = 0;
+    uint64_t now;
+    int i, j;
+
+    if (data->nack){
+        data->stats.nacks++;
+        return -EIO;
+    }
+
+    now = mlx90632_emul_now_us();
+    mlx90632_emul_update(data, now);
+    data->stats.transfers++;
+
+    for (i = 0; i < num_msgs; i++){
+        if (msgs[i].flags & I2C_MSG_READ){
+            if ((wlen != 2) || (msgs[i].len & 1))
+                return -EIO;
+
+            reg = ((uint16_t)wbuf[0] << 8) | wbuf[1];
+            for (j = 0; j < (int)(msgs[i].len / 2); j++){
+                value = mlx90632_emul_reg_read(data, (uint16_t)(reg + j), now);
+                msgs[i].buf[2 * j] = (uint8_t)(value >> 8);
+                msgs[i].buf[2 * j + 1] = (uint8_t)(value & 0xFF);
+            }
+
+            data->stats.reads++;
+            data->stats.words_read += msgs[i].len / 2;
+            if (reg == MLX90632_REG_STATUS)
+                data->stats.status_reads++;
+            if ((reg >= MLX90632_ADDR_RAM) && (reg < MLX90632_ADDR_RAM + MLX90632_EMUL_RAM_LEN) && data->ready_pending){
+                latency = (uint32_t)(now - data->ready_us);
+                data->stats.samples_read++;
+                data->stats.latency_total_us += latency;
+                data->stats.latency_min_us = MIN(data->stats.latency_min_us, latency);
+                data->stats.latency_max_us = MAX(data->stats.latency_max_us, latency);
+                data->ready_pending = false;
+            }
+            wlen = 0;
+            continue;
+        }
+
+        for (j = 0; (j < (int)msgs[i].len) && (wlen < sizeof(wbuf)); j++)
+            wbuf[wlen++] = msgs[i].buf[j];
+
+        if (wlen == sizeof(wbuf)){
+            mlx90632_emul_reg_write(data, ((uint16_t)wbuf[0] << 8) | wbuf[1], ((uint16_t)wbuf[2] << 8) | wbuf[3], now);
+            data->stats.writes++;
+            wlen = 0;
+        }
+    }
+
+    return 0;
+}
+
+static struct i2c_emul_api mlx90632_emul_api_i2c = {
+    .transfer = mlx90632_emul_transfer,
+};
+
+void mlx90632_emul_set_profile(const struct emul *target, MLXEmulProfile_t profile){
+    struct mlx90632_emul_data *data = target->data;
+
+    data->profile = (profile != NULL) ? profile : mlx90632_emul_default_profile;
+}
+
+void mlx90632_emul_set_nack(const struct emul *target, bool nack){
+    struct mlx90632_emul_data *data = target->data;
+
+    data->nack = nack;
+}
+
+void mlx90632_emul_get_stats(const struct emul *target, MLXEmulStats_s *stats){
+    struct mlx90632_emul_data *data = target->data;
+
+    *stats = data->stats;
+}
+
+void mlx90632_emul_reset_stats(const struct emul *target){
+    struct mlx90632_emul_data *data = target->data;
+
+    memset(&data->stats, 0, sizeof(data->stats));
+    data->stats.latency_min_us = UINT32_MAX;
+}
+
+static int mlx90632_emul_init(const struct emul *target, const struct device *parent){
+    struct mlx90632_emul_data *data = target->data;
+    const struct mlx90632_emul_cfg *cfg = target->cfg;
+    size_t i;
+
+    memset(data, 0, sizeof(*data));
+    MLX90632_EMUL_EE(MLX90632_EE_ID0) = 0x1234;
+    MLX90632_EMUL_EE(MLX90632_EE_ID1) = 0x5678;
+    MLX90632_EMUL_EE(MLX90632_EE_ID2) = 0x9abc;
+    MLX90632_EMUL_EE(MLX90632_EE_VERSION) = MLX90632_DSPv5;
+    for (i = 0; i < ARRAY_SIZE(mlx90632_emul_calib); i++){
+        MLX90632_EMUL_EE(mlx90632_emul_calib[i].addr) = (uint16_t)(mlx90632_emul_calib[i].value & 0xFFFF);
+        if (mlx90632_emul_calib[i].width == 32)
+            MLX90632_EMUL_EE(mlx90632_emul_calib[i].addr + 1) = (uint16_t)((uint32_t)mlx90632_emul_calib[i].value >> 16);
+    }
+    MLX90632_EMUL_EE(MLX90632_EE_CTRL) = MLX90632_EMUL_EE_CTRL;
+    MLX90632_EMUL_EE(MLX90632_EE_I2C_ADDRESS) = cfg->addr >> 1;
+    MLX90632_EMUL_EE(MLX90632_EE_MEDICAL_MEAS1) = MLX90632_EMUL_EE_MEAS1;
+    MLX90632_EMUL_EE(MLX90632_EE_MEDICAL_MEAS2) = MLX90632_EMUL_EE_MEAS2;
+
+    data->profile = mlx90632_emul_default_profile;
+    data->t0_us = mlx90632_emul_now_us();
+    data->stats.latency_min_us = UINT32_MAX;
+    mlx90632_emul_reset(data, data->t0_us);
+
+    return 0;
+}
+
+#define MLX90632_EMUL(n)                                                                    \
+    static struct mlx90632_emul_data mlx90632_emul_data_##n;                                \
+    static const struct mlx90632_emul_cfg mlx90632_emul_cfg_##n = {                         \
+        .addr = DT_INST_REG_ADDR(n),                                                        \
+    };                                                                                      \
+    EMUL_DT_INST_DEFINE(n, mlx90632_emul_init, &mlx90632_emul_data_##n,                     \
+                        &mlx90632_emul_cfg_##n, &mlx90632_emul_api_i2c);
+
+DT_INST_FOREACH_STATUS_OKAY(MLX90632_EMUL)
@@ -0,0 +1,263 @@
+/**
+ * @file mlx90632_extended_meas.c
+ * @brief MLX90632 extended range measurement support functions
+ * @internal
+ *
+ * @copyright (C) 2017 Melexis N.V.
+ * @copyright (c) 2025 Marconatale Parise.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @endinternal
+ *
+ * @details
+ * Measurement type switch and the Melexis reference formulas of the extended range, working on
+ * the eeprom register values. The acquisition path does not use these formulas: it reads the
+ * extended table with mlx90632_readTempRawExtended() and converts it with the kernels of
+ * mlx90632_kernel.h, like the medical table.
+ *
+ * @addtogroup mlx90632_private MLX90632 Internal library functions
+ * @{
+ *
+ */
+#include "mlx90632.h"
+
+LOG_MODULE_DECLARE(mlx90632, CONFIG_MLX90632_LOG_LEVEL);
+
+#define POW10 10000000000LL
+
+#ifdef TEST
+int32_t mlx90632_read_temp_ambient_raw_extended(int16_t *ambient_new_raw, int16_t *ambient_old_raw){
+    int32_t ret;
+    uint16_t ram[2];
+
+    ret = mlx90632_i2c_read(MLX90632_RAM_3(17), &ram[0]);
+    if (ret < 0)
+        return ret;
+    ret = mlx90632_i2c_read(MLX90632_RAM_3(18), &ram[1]);
+    if (ret < 0)
+        return ret;
+
+    *ambient_new_raw = (int16_t)ram[0];
+    *ambient_old_raw = (int16_t)ram[1];
+    return ret;
+}
+
+int32_t mlx90632_read_temp_object_raw_extended(int16_t *object_new_raw){
+    int32_t ret;
+    uint16_t ram[MLX90632_RAM_EXT_BLOCK_LEN];
+    MLXTempRaw_s raw;
+
+    ret = mlx90632_i2c_read_block(MLX90632_RAM_EXT_BLOCK_START, ram, MLX90632_RAM_EXT_BLOCK_LEN);
+    if (ret < 0)
+        return ret;
+
+    ret = mlx90632_decodeTempRawExtended(ram, &raw);
+    if (ret < 0)
+        return ret;
+
+    *object_new_raw = raw.object_ram_4_7;
+    return ret;
+}
+#endif
+
+/* The whole extended window in one read, split like the two reads of the Melexis library */
+static int32_t mlx90632_read_temp_raw_extended_window(int16_t *ambient_new_raw, int16_t *ambient_old_raw, int16_t *object_new_raw){
+    int32_t ret;
+    uint16_t ram[MLX90632_RAM_EXT_BLOCK_LEN];
+    MLXTempRaw_s raw;
+
+    ret = mlx90632_i2c_read_block(MLX90632_RAM_EXT_BLOCK_START, ram, MLX90632_RAM_EXT_BLOCK_LEN);
+    if (ret < 0)
+        return ret;
+
+    ret = mlx90632_decodeTempRawExtended(ram, &raw);
+    if (ret < 0)
+        return ret;
+
+    *ambient_new_raw = raw.ambient_ram_6;
+    *ambient_old_raw = raw.ambient_ram_9;
+    *object_new_raw = raw.object_ram_4_7;
+    return ret;
+}
+
+int32_t mlx90632_read_temp_raw_extended(int16_t *ambient_new_raw, int16_t *ambient_old_raw, int16_t *object_new_raw){
+    int start_measurement_ret;
+    int tries = 3;
+
+    //the table is complete when cycle position 19 is measured
+    while (tries-- > 0){
+        start_measurement_ret = mlx90632_start_measurement();
+        if (start_measurement_ret < 0)
+            return start_measurement_ret;
+        if (start_measurement_ret == MLX90632_EXTENDED_LAST_POS)
+            break;
+    }
+    if (tries < 0)
+        return -ETIMEDOUT;
+
+    return mlx90632_read_temp_raw_extended_window(ambient_new_raw, ambient_old_raw, object_new_raw);
+}
+
+int32_t mlx90632_read_temp_raw_extended_burst(int16_t *ambient_new_raw, int16_t *ambient_old_raw, int16_t *object_new_raw){
+    int32_t ret;
+
+    ret = mlx90632_start_measurement_burst();
+    if (ret < 0)
+        return ret;
+
+    return mlx90632_read_temp_raw_extended_window(ambient_new_raw, ambient_old_raw, object_new_raw);
+}
+
+double mlx90632_preprocess_temp_ambient_extended(int16_t ambient_new_raw, int16_t ambient_old_raw, int16_t Gb){
+    double VR_Ta, kGb;
+
+    kGb = ((double)Gb) / 1024.0;
+
+    VR_Ta = ambient_old_raw + kGb * (ambient_new_raw / (MLX90632_REF_3));
+    return ((ambient_new_raw / (MLX90632_REF_3)) / VR_Ta) * 524288.0;
+}
+
+double mlx90632_preprocess_temp_object_extended(int16_t object_new_raw, int16_t ambient_new_raw,
+                                                int16_t ambient_old_raw, int16_t Ka){
+    double VR_IR, kKa;
+
+    kKa = ((double)Ka) / 1024.0;
+
+    VR_IR = ambient_old_raw + kKa * (ambient_new_raw / (MLX90632_REF_3));
+    return ((object_new_raw / (MLX90632_REF_12)) / VR_IR) * 524288.0;
+}
+
+double mlx90632_calc_temp_ambient_extended(int16_t ambient_new_raw, int16_t ambient_old_raw, int32_t P_T,
+                                           int32_t P_R, int32_t P_G, int32_t P_O, int16_t Gb){
+    double Asub, Bsub, Ablock, Bblock, Cblock, AMB;
+
+    AMB = mlx90632_preprocess_temp_ambient_extended(ambient_new_raw, ambient_old_raw, Gb);
+
+    Asub = ((double)P_T) / (double)17592186044416.0;
+    Bsub = AMB - ((double)P_R / (double)256.0);
+    Ablock = Asub * (Bsub * Bsub);
+    Bblock = (Bsub / (double)P_G) * (double)1048576.0;
+    Cblock = (double)P_O / (double)256.0;
+
+    return Bblock + Ablock + Cblock;
+}
+
+static double mlx90632_calc_temp_object_iteration_extended(double prev_object_temp, int32_t object, double TAdut, double TaTr4,
+                                                           int32_t Ga, int32_t Fa, int32_t Fb, int16_t Ha, int16_t Hb,
+                                                           double emissivity){
+    double calcedGa, calcedGb, calcedFa, first_sqrt;
+    double KsTAtmp, Alpha_corr;
+    double Ha_customer, Hb_customer;
+
+    Ha_customer = Ha / ((double)16384.0);
+    Hb_customer = Hb / ((double)1024.0);
+    calcedGa = ((double)Ga * (prev_object_temp - 25)) / ((double)68719476736.0);
+    KsTAtmp = (double)Fb * (TAdut - 25);
+    calcedGb = KsTAtmp / ((double)68719476736.0);
+    Alpha_corr = (((double)(Fa * POW10)) * Ha_customer * (double)(1 + calcedGa + calcedGb)) /
+                 ((double)70368744177664.0);
+    calcedFa = object / (emissivity * (Alpha_corr / POW10));
+
+    first_sqrt = sqrt(calcedFa + TaTr4);
+
+    return sqrt(first_sqrt) - 273.15 - Hb_customer;
+}
+
+double mlx90632_calc_temp_object_extended(int32_t object, int32_t ambient, double reflected,
+                                          int32_t Ea, int32_t Eb, int32_t Ga, int32_t Fa, int32_t Fb,
+                                          int16_t Ha, int16_t Hb){
+    double kEa, kEb, TAdut;
+    double temp = 25.0;
+    double tmp_emi = mlx90632_get_emissivity();
+    double TaTr4;
+    double ta4;
+    int i;
+
+    kEa = ((double)Ea) / ((double)65536.0);
+    kEb = ((double)Eb) / ((double)256.0);
+    TAdut = (((double)ambient) - kEb) / kEa + 25;
+
+    //reflected and sensor temperature weighted by the emissivity
+    TaTr4 = reflected + 273.15;
+    TaTr4 = TaTr4 * TaTr4;
+    TaTr4 = TaTr4 * TaTr4;
+    ta4 = TAdut + 273.15;
+    ta4 = ta4 * ta4;
+    ta4 = ta4 * ta4;
+    TaTr4 = TaTr4 - (TaTr4 - ta4) / tmp_emi;
+
+    for (i = 0; i < 5; ++i)
+    {
+        temp = mlx90632_calc_temp_object_iteration_extended(temp, object, TAdut, TaTr4, Ga, Fa, Fb, Ha, Hb, tmp_emi);
+    }
+    return temp;
+}
+
+int32_t mlx90632_set_meas_type(uint8_t type){
+    int32_t ret;
+    uint16_t reg_ctrl;
+
+    if ((type != MLX90632_MTYP_MEDICAL) && (type != MLX90632_MTYP_EXTENDED) &&
+        (type != MLX90632_MTYP_MEDICAL_BURST) && (type != MLX90632_MTYP_EXTENDED_BURST))
+        return -EINVAL;
+
+    ret = mlx90632_addressed_reset();
+    if (ret < 0)
+        return ret;
+
+    ret = mlx90632_i2c_read(MLX90632_REG_CTRL, &reg_ctrl);
+    if (ret < 0)
+        return ret;
+
+    //the table is switched in halt mode
+    reg_ctrl &= ~(MLX90632_CFG_MTYP_MASK | MLX90632_CFG_PWR_MASK | MLX90632_CFG_SOC_MASK | MLX90632_CFG_SOB_MASK);
+    reg_ctrl |= MLX90632_MTYP_STATUS(MLX90632_MEASUREMENT_TYPE_STATUS(type)) | MLX90632_PWR_STATUS_HALT;
+    ret = mlx90632_i2c_write(MLX90632_REG_CTRL, reg_ctrl);
+    if (ret < 0)
+        return ret;
+
+    reg_ctrl &= ~MLX90632_CFG_PWR_MASK;
+    if (MLX90632_MEASUREMENT_BURST_STATUS(type))
+        reg_ctrl |= MLX90632_PWR_STATUS_SLEEP_STEP;
+    else
+        reg_ctrl |= MLX90632_PWR_STATUS_CONTINUOUS;
+    ret = mlx90632_i2c_write(MLX90632_REG_CTRL, reg_ctrl);
+    if (ret < 0)
+        return ret;
+
+    MLX_STS.meas_type = type;
+    MLX_STS.mode = MLX90632_CFG_PWR(reg_ctrl);
+    MLX_STS.refresh = mlx90632_get_refresh_rate();
+    MLX_STS.conv_time_us = mlx90632_calc_conv_time((mlx90632_meas_t)MLX_STS.refresh);
+    LOG("Measurement type 0x%02X, refresh value is %d", type, MLX_STS.refresh);
+
+    return 0;
+}
+
+int32_t mlx90632_get_meas_type(void){
+    int32_t ret;
+    uint16_t reg_ctrl;
+
+    ret = mlx90632_i2c_read(MLX90632_REG_CTRL, &reg_ctrl);
+    if (ret < 0)
+        return ret;
+
+    ret = MLX90632_MTYP(reg_ctrl);
+    if (MLX90632_CFG_PWR(reg_ctrl) == MLX90632_PWR_STATUS_SLEEP_STEP)
+        ret = MLX90632_BURST_MEASUREMENT_TYPE(ret);
+
+    return ret;
+}
+
+///@}
@@ -0,0 +1,112 @@
+/******************************************************************************
+ * Copyright (c) 2025 Marconatale Parise.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * You may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************/
+/**
+ * @file mlx90632_filter.c
+ * @brief filter stage between conversion and publication of temperatures
+ *
+ * State and arithmetic are single precision, done by the FPU of the Cortex-M33: the filtered
+ * value is far below the float resolution at body and ambient temperatures.
+ *
+ */
+#include <string.h>
+#include "mlx90632_filter.h"
+
+static void mlx90632_filter_channel_reset(MLXFilterChannel_s *ch){
+    memset(ch, 0, sizeof(*ch));
+}
+
+void mlx90632_filter_init(MLXFilter_s *filter, const MLXFilterConfig_s *cfg){
+    memset(filter, 0, sizeof(*filter));
+    if (cfg == NULL){
+        filter->cfg.type = MLX90632_FILTER_NONE;
+        return;
+    }
+
+    filter->cfg = *cfg;
+    filter->cfg.median_len = MAX(MIN(filter->cfg.median_len, MLX90632_FILTER_MEDIAN_MAX), 1);
+    if ((filter->cfg.median_len & 1) == 0)
+        filter->cfg.median_len--;
+}
+
+void mlx90632_filter_reset(MLXFilter_s *filter){
+    mlx90632_filter_channel_reset(&filter->ambient);
+    mlx90632_filter_channel_reset(&filter->object);
+}
+
+/* Insertion sort of a copy of the window, at most MLX90632_FILTER_MEDIAN_MAX elements */
+static float mlx90632_filter_median(MLXFilterChannel_s *ch, uint8_t len, float x){
+    float sorted[MLX90632_FILTER_MEDIAN_MAX];
+    float v;
+    int i, j;
+
+    ch->window[ch->next] = x;
+    ch->next = (uint8_t)((ch->next + 1) % len);
+    if (ch->count < len)
+        ch->count++;
+
+    for (i = 0; i < ch->count; i++){
+        v = ch->window[i];
+        for (j = i; (j > 0) && (sorted[j - 1] > v); j--)
+            sorted[j] = sorted[j - 1];
+        sorted[j] = v;
+    }
+    //until the window is full the median of the samples received
+    return sorted[ch->count / 2];
+}
+
+static float mlx90632_filter_kalman(MLXFilterChannel_s *ch, float q, float r, float x){
+    float k;
+
+    ch->p += q;
+    k = ch->p / (ch->p + r);
+    ch->value += k * (x - ch->value);
+    ch->p *= 1.0f - k;
+    return ch->value;
+}
+
+static double mlx90632_filter_step(const MLXFilterConfig_s *cfg, MLXFilterChannel_s *ch, double sample){
+    float x = (float)sample;
+
+    if (!ch->primed){
+        ch->primed = true;
+        ch->value = x;
+        ch->p = cfg->kalman_r;
+        if (cfg->type == MLX90632_FILTER_MEDIAN)
+            return mlx90632_filter_median(ch, cfg->median_len, x);
+        return sample;
+    }
+
+    switch (cfg->type){
+    case MLX90632_FILTER_EMA:
+        ch->value += cfg->ema_alpha * (x - ch->value);
+        return ch->value;
+    case MLX90632_FILTER_MEDIAN:
+        return mlx90632_filter_median(ch, cfg->median_len, x);
+    case MLX90632_FILTER_KALMAN:
+        return mlx90632_filter_kalman(ch, cfg->kalman_q, cfg->kalman_r, x);
+    default:
+        return sample;
+    }
+}
+
+void mlx90632_filter_apply(MLXFilter_s *filter, MLXTemp_s *temp){
+    if (filter->cfg.type == MLX90632_FILTER_NONE)
+        return;
+
+    temp->ambient = mlx90632_filter_step(&filter->cfg, &filter->ambient, temp->ambient);
+    temp->object = mlx90632_filter_step(&filter->cfg, &filter->object, temp->object);
+}
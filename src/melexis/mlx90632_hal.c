@@ -19,35 +19,110 @@
  * @brief Abstraction of i2c protocol interface
  *
  * This implementation file provides an abstraction interface to manage i2c peripheral.
+ * Transfers go through the installed MLXBus_s (see mlx90632_bus.h).
  * 
  * @author Marconatale Parise
  * @date 09 June 2025
  *
  */
 #include "mlx90632_hal.h"
+#include <string.h>
+
+LOG_MODULE_REGISTER(mlx90632_bus, CONFIG_MLX90632_BUS_LOG_LEVEL);
 
 uint8_t error_melexis90632 = 0;
 
-extern int32_t mlx90632_i2c_read(int16_t register_address, uint16_t *value)
+#ifdef __ZEPHYR__
+#define MLX90632_BUS_DEFAULT (&mlx90632_bus_zephyr)
+#else
+#define MLX90632_BUS_DEFAULT (&mlx90632_bus_linux)
+#endif
+
+static const MLXBus_s *mlx90632_bus = MLX90632_BUS_DEFAULT;
+
+void mlx90632_bus_set(const MLXBus_s *bus)
+{
+    mlx90632_bus = (bus != NULL) ? bus : MLX90632_BUS_DEFAULT;
+}
+
+const MLXBus_s *mlx90632_bus_get(void)
+{
+    return mlx90632_bus;
+}
+
+#if MLX_BUS_STATS
+//linux i2c-dev reports a NACK as EREMOTEIO, not defined by every libc
+#ifdef EREMOTEIO
+#define MLX90632_EREMOTEIO (-EREMOTEIO)
+#else
+#define MLX90632_EREMOTEIO (-EIO)
+#endif
+
+static MLXBusStats_s mlx90632_bus_stats;
+static struct k_spinlock mlx90632_bus_stats_lock;
+
+static mlx90632_reg_class_t mlx90632_reg_class(uint16_t reg)
+{
+    if ((reg >= 0x2400) && (reg <= 0x27FF))
+        return MLX90632_REG_CLASS_EEPROM;
+    if ((reg >= 0x4000) && (reg <= 0x4FFF))
+        return MLX90632_REG_CLASS_RAM;
+    if (reg == 0x3FFF)
+        return MLX90632_REG_CLASS_STATUS;
+    if ((reg >= 0x3000) && (reg <= 0x3FFE))
+        return MLX90632_REG_CLASS_CTRL;
+    return MLX90632_REG_CLASS_OTHER;
+}
+
+static uint64_t mlx90632_bus_now(void)
 {
-    //uint8_t *buf_read;
-    uint8_t reg_write[2] = {0};
-    struct i2c_msg msg[2];
-    uint16_t buf_read;
+    return mlx90632_bus->now_us(mlx90632_bus->ctx);
+}
 
-    reg_write[0] = (register_address >> 8); //MSB
-    reg_write[1] = (register_address & 0xFF); //LSB
+/* Account one transaction of bytes on the wire, started at start_us, that returned ret */
+static void mlx90632_bus_account(uint16_t reg, bool write, uint32_t bytes, uint64_t start_us, int32_t ret)
+{
+    MLXBusClassStats_s *cls = &mlx90632_bus_stats.cls[mlx90632_reg_class(reg)];
+    uint32_t latency = (uint32_t)(mlx90632_bus_now() - start_us);
+    uint32_t bucket = 0;
+    k_spinlock_key_t key;
 
-	msg[0].buf = (uint8_t *)reg_write;
-	msg[0].len = sizeof(reg_write);
-	msg[0].flags = I2C_MSG_WRITE;
+    if (latency)
+        bucket = MIN(32U - (uint32_t)__builtin_clz(latency), MLX90632_BUS_HIST_BUCKETS - 1U);
 
-	msg[1].buf = (uint8_t *)value;
-	msg[1].len = 2;
-	msg[1].flags = I2C_MSG_RESTART | I2C_MSG_READ | I2C_MSG_STOP;
+    key = k_spin_lock(&mlx90632_bus_stats_lock);
+    if (write)
+        cls->writes++;
+    else
+        cls->reads++;
+    cls->bytes += bytes;
+
+    if ((ret == -EIO) || (ret == -ENXIO) || (ret == MLX90632_EREMOTEIO))
+        cls->nacks++;
+    else if ((ret == -ETIMEDOUT) || (ret == -EAGAIN))
+        cls->timeouts++;
+    else if (ret)
+        cls->errors++;
 
-    if(i2c_transfer(I2C_DEV, msg, 2, 0x3A))
-    //if(i2c_write_read(i2c_dev, 0x3A, &reg_write, sizeof(reg_write), value, 2))
+    cls->hist[bucket]++;
+    cls->latency_max_us = MAX(cls->latency_max_us, latency);
+    cls->latency_total_us += latency;
+    k_spin_unlock(&mlx90632_bus_stats_lock, key);
+}
+#endif
+
+extern int32_t mlx90632_i2c_read(int16_t register_address, uint16_t *value)
+{
+    int32_t ret;
+#if MLX_BUS_STATS
+    uint64_t start = mlx90632_bus_now();
+#endif
+
+    ret = mlx90632_bus->read(mlx90632_bus->ctx, (uint16_t)register_address, value);
+#if MLX_BUS_STATS
+    mlx90632_bus_account((uint16_t)register_address, false, 4, start, ret);
+#endif
+    if(ret)
     {
 		LOG_MLX("Fail to read to sensor");
         error_melexis90632 = (uint8_t)(error_melexis90632 | ERROR_MLX_READ);
@@ -55,33 +130,47 @@ extern int32_t mlx90632_i2c_read(int16_t register_address, uint16_t *value)
 	}
     else
     {
-        buf_read = *value;
-        *value = (buf_read >> 8) | ((buf_read & 0x00FF)<<8);
         error_melexis90632 = (uint8_t)(error_melexis90632 & (~ERROR_MLX_READ));
         return 0;
     }
 }
 
-extern int32_t mlx90632_i2c_write(int16_t register_address, uint16_t value)
+extern int32_t mlx90632_i2c_read_block(int16_t register_address, uint16_t *value, uint16_t len)
 {
-    uint8_t reg_write[2]; 
-    uint8_t data[2];
-    struct i2c_msg msg[2];
-
-    reg_write[0] = (register_address >> 8); //MSB
-    reg_write[1] = (register_address & 0xFF); //LSB
-    data[0] = (value >> 8); //MSB
-    data[1] = (value & 0xFF); //LSB
+    int32_t ret;
+#if MLX_BUS_STATS
+    uint64_t start = mlx90632_bus_now();
+#endif
 
-	msg[0].buf = &reg_write;
-	msg[0].len = sizeof(reg_write);
-	msg[0].flags = I2C_MSG_WRITE;
+    ret = mlx90632_bus->read_block(mlx90632_bus->ctx, (uint16_t)register_address, value, len);
+#if MLX_BUS_STATS
+    mlx90632_bus_account((uint16_t)register_address, false, 2U + 2U * len, start, ret);
+#endif
+    if(ret)
+    {
+		LOG_MLX("Fail to read block from sensor");
+        error_melexis90632 = (uint8_t)(error_melexis90632 | ERROR_MLX_READ);
+		return -1;
+	}
+    else
+    {
+        error_melexis90632 = (uint8_t)(error_melexis90632 & (~ERROR_MLX_READ));
+        return 0;
+    }
+}
 
-	msg[1].buf = &data;
-	msg[1].len = sizeof(data);
-	msg[1].flags = I2C_MSG_WRITE | I2C_MSG_STOP;
+extern int32_t mlx90632_i2c_write(int16_t register_address, uint16_t value)
+{
+    int32_t ret;
+#if MLX_BUS_STATS
+    uint64_t start = mlx90632_bus_now();
+#endif
 
-    if(i2c_transfer(I2C_DEV, msg, 2, 0x3A))
+    ret = mlx90632_bus->write(mlx90632_bus->ctx, (uint16_t)register_address, value);
+#if MLX_BUS_STATS
+    mlx90632_bus_account((uint16_t)register_address, true, 4, start, ret);
+#endif
+    if(ret)
     {
 		LOG_MLX("Fail to write to sensor");
         error_melexis90632 = (uint8_t)(error_melexis90632 | ERROR_MLX_WRITE);
@@ -98,4 +187,56 @@ extern int32_t mlx90632_i2c_write(int16_t register_address, uint16_t value)
 extern uint8_t get_melexis_error(void)
 {
     return error_melexis90632;
-}
\ No newline at end of file
+}
+void mlx90632_i2c_get_stats(MLXBusStats_s *stats)
+{
+#if MLX_BUS_STATS
+    k_spinlock_key_t key = k_spin_lock(&mlx90632_bus_stats_lock);
+
+    *stats = mlx90632_bus_stats;
+    k_spin_unlock(&mlx90632_bus_stats_lock, key);
+#else
+    memset(stats, 0, sizeof(*stats));
+#endif
+}
+
+void mlx90632_i2c_reset_stats(void)
+{
+#if MLX_BUS_STATS
+    k_spinlock_key_t key = k_spin_lock(&mlx90632_bus_stats_lock);
+
+    memset(&mlx90632_bus_stats, 0, sizeof(mlx90632_bus_stats));
+    k_spin_unlock(&mlx90632_bus_stats_lock, key);
+#endif
+}
+
+void mlx90632_i2c_dump_stats(void)
+{
+    static const char *const names[MLX90632_REG_CLASSES] = {"eeprom", "ram", "ctrl", "status", "other"};
+    MLXBusStats_s stats;
+    const MLXBusClassStats_s *cls;
+    uint32_t count;
+    int i, b;
+
+    mlx90632_i2c_get_stats(&stats);
+    for (i = 0; i < MLX90632_REG_CLASSES; i++)
+    {
+        cls = &stats.cls[i];
+        count = cls->reads + cls->writes;
+        if (count == 0)
+            continue;
+        printk("i2c %-6s rd %u wr %u bytes %u nack %u tmo %u err %u lat mean %u max %u us |",
+               names[i], cls->reads, cls->writes, cls->bytes, cls->nacks, cls->timeouts, cls->errors,
+               (uint32_t)(cls->latency_total_us / count), cls->latency_max_us);
+        for (b = 0; b < MLX90632_BUS_HIST_BUCKETS; b++)
+        {
+            if (cls->hist[b] == 0)
+                continue;
+            if (b == MLX90632_BUS_HIST_BUCKETS - 1)
+                printk(" >=%lu:%u", BIT(b - 1), cls->hist[b]);
+            else
+                printk(" <%lu:%u", BIT(b), cls->hist[b]);
+        }
+        printk("\n");
+    }
+}
@@ -0,0 +1,461 @@
+/**
+ * @file mlx90632_kernel.c
+ * @brief MLX90632 single-precision and fixed-point temperature kernels
+ * @internal
+ *
+ * @copyright (c) 2025 Marconatale Parise.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @endinternal
+ *
+ * @details
+ * Fixed-point layout of the Q kernel:
+ * - AMB and AMB - P_R are Q16, P_R/P_O/Eb are stored in eeprom scaling (Q8)
+ * - Sto is Q12, temperatures are Q16
+ * - TAk4 and the radicand are integers (about 2^33 at room temperature)
+ * - the fourth root is computed with two integer square roots to Q22
+ *
+ * @addtogroup mlx90632_private MLX90632 Internal library functions
+ * @{
+ *
+ */
+#include "mlx90632_kernel.h"
+#include <stdlib.h>
+#include <string.h>
+
+MLXPrepared_s MLX_KP;
+/* MLX_KP is rebuilt by the acquisition thread (init, i2c recovery) while the processing thread
+ * computes with it: writers publish and readers copy it under this lock */
+static struct k_spinlock mlx90632_kp_lock;
+MLXSolver_s MLX_SV = {.tolerance = MLX_SOLVER_TOLERANCE, .max_iter = MLX90632_SOLVER_MAX_ITER};
+
+static int64_t mlx90632_to_q(double value, int frac){
+    return (int64_t)llround(ldexp(value, frac));
+}
+
+static void mlx90632_prepare_q(const MLXCalib_s *calib, double emi, MLXCalibQ_s *q){
+    q->P_R_q8 = mlx90632_to_q(calib->P_R, 8);
+    q->P_G_q20 = mlx90632_to_q(calib->P_G, 20);
+    q->P_T_q44 = mlx90632_to_q(calib->P_T, 44);
+    q->P_O_q8 = mlx90632_to_q(calib->P_O, 8);
+    q->Ea_q16 = mlx90632_to_q(calib->Ea, 16);
+    q->Eb_q8 = mlx90632_to_q(calib->Eb, 8);
+    q->Fb_q36 = mlx90632_to_q(calib->Fb, 36);
+    q->Ga_q36 = mlx90632_to_q(calib->Ga, 36);
+    q->Gb_q10 = mlx90632_to_q(calib->Gb, 10);
+    q->Ka_q10 = mlx90632_to_q(calib->Ka, 10);
+    q->Hb_q16 = mlx90632_to_q(calib->Hb, 16);
+    q->K_q8 = mlx90632_to_q(1.0 / (emi * calib->Fa * calib->Ha), 8);
+
+    //avoid division by zero in kernels with blank calibration
+    if (q->P_G_q20 == 0)
+        q->P_G_q20 = 1;
+    if (q->Ea_q16 == 0)
+        q->Ea_q16 = 1;
+}
+
+void mlx90632_prepare(const MLXCalib_s *calib, double emi, MLXPrepared_s *prep){
+    MLXPrepD_s *d = &prep->d;
+    MLXPrepF_s *f = &prep->f;
+
+    d->amb_scale = MLX90632_AMB_SCALE;
+    d->Gb_12 = calib->Gb / MLX90632_REF_3;
+    d->Ka_12 = calib->Ka / MLX90632_REF_3;
+    d->P_R = calib->P_R;
+    d->inv_PG = 1.0 / calib->P_G;
+    d->P_T = calib->P_T;
+    d->P_O = calib->P_O;
+    d->Eb = calib->Eb;
+    d->inv_Ea = 1.0 / calib->Ea;
+    d->inv_emiFaHa = 1.0 / (emi * calib->Fa * calib->Ha);
+    d->Ga = calib->Ga;
+    d->Fb = calib->Fb;
+    d->Hb = calib->Hb;
+
+    f->amb_scale = (float)d->amb_scale;
+    f->Gb_12 = (float)d->Gb_12;
+    f->Ka_12 = (float)d->Ka_12;
+    f->P_R = (float)d->P_R;
+    f->inv_PG = (float)d->inv_PG;
+    f->P_T = (float)d->P_T;
+    f->P_O = (float)d->P_O;
+    f->Eb = (float)d->Eb;
+    f->inv_Ea = (float)d->inv_Ea;
+    f->inv_emiFaHa = (float)d->inv_emiFaHa;
+    f->Ga = (float)d->Ga;
+    f->Fb = (float)d->Fb;
+    f->Hb = (float)d->Hb;
+
+    mlx90632_prepare_q(calib, emi, &prep->q);
+}
+
+void mlx90632_kernel_prepare(void){
+    MLXPrepared_s prep;
+    k_spinlock_key_t key;
+
+    mlx90632_prepare(&MLX_K, mlx90632_get_emissivity(), &prep);
+
+    key = k_spin_lock(&mlx90632_kp_lock);
+    MLX_KP = prep;
+    k_spin_unlock(&mlx90632_kp_lock, key);
+}
+
+void mlx90632_kernel_snapshot(MLXPrepared_s *prep){
+    k_spinlock_key_t key = k_spin_lock(&mlx90632_kp_lock);
+
+    *prep = MLX_KP;
+    k_spin_unlock(&mlx90632_kp_lock, key);
+}
+
+/* AMB = (ram_6 / 12) / (ram_9 + Gb * ram_6 / 12) * 2^19, shared by ambient and object */
+static double mlx90632_amb_d(const MLXTempRaw_s *raw, const MLXPrepD_s *k){
+    return raw->ambient_ram_6 * k->amb_scale / (raw->ambient_ram_9 + k->Gb_12 * raw->ambient_ram_6);
+}
+
+static double mlx90632_ambient_from_amb_d(double AMB, const MLXPrepD_s *k){
+    double d = AMB - k->P_R;
+
+    return k->P_O + d * k->inv_PG + k->P_T * (d * d);
+}
+
+/*
+ * Iterate from seed until the change between two iterations is below tol or max_iter is reached,
+ * iterations used in *iter, *converged set if the change went below tol. TOdut = f(TOdut) is a
+ * contraction with factor L = |df/dTOdut| << 1, so the error left is well below the last change.
+ */
+static double mlx90632_object_from_amb_d(const MLXTempRaw_s *raw, double AMB, const MLXPrepD_s *k,
+                                         double seed, double tol, int max_iter, int *iter, bool *converged){
+    double Sto_k, TAdut, TK, TAk4, fb_term, prev, g, y, x, root;
+    double TOdut = seed;
+    int i;
+
+    //Sto / (emi * Fa * Ha) with S = (ram_4_7 + ram_5_8) / 2
+    Sto_k = (raw->object_ram_4_7 + raw->object_ram_5_8) * 0.5 * k->amb_scale * k->inv_emiFaHa
+            / (raw->ambient_ram_9 + k->Ka_12 * raw->ambient_ram_6);
+
+    TAdut = (AMB - k->Eb) * k->inv_Ea + 25.0;
+    TK = TAdut + 273.15;
+    TAk4 = (TK * TK) * (TK * TK);
+    fb_term = 1.0 + k->Fb * (TAdut - 25.0);
+
+    *converged = false;
+    for (i = 0; i < max_iter; ++i)
+    {
+        prev = TOdut;
+        g = fb_term + k->Ga * (TOdut - 25.0);
+        y = Sto_k / g;
+        x = y + TAk4;
+        root = sqrt(sqrt(x));
+        TOdut = root - 273.15 - k->Hb;
+        if (fabs(TOdut - prev) < tol){
+            *converged = true;
+            ++i;
+            break;
+        }
+    }
+    *iter = i;
+
+    return TOdut;
+}
+
+double mlx90632_calc_temp_ambient_d(const MLXTempRaw_s *raw, const MLXPrepared_s *prep){
+    return mlx90632_ambient_from_amb_d(mlx90632_amb_d(raw, &prep->d), &prep->d);
+}
+
+double mlx90632_calc_temp_object_d(const MLXTempRaw_s *raw, const MLXPrepared_s *prep){
+    int iter;
+    bool converged;
+
+    return mlx90632_object_from_amb_d(raw, mlx90632_amb_d(raw, &prep->d), &prep->d,
+                                      25.0, 0.0, MLX90632_FIXED_ITER, &iter, &converged);
+}
+
+void mlx90632_calc_temp_d(const MLXTempRaw_s *raw, const MLXPrepared_s *prep, MLXTemp_s *temp){
+    double AMB = mlx90632_amb_d(raw, &prep->d);
+    int iter;
+    bool converged;
+
+    temp->ambient = mlx90632_ambient_from_amb_d(AMB, &prep->d);
+    temp->object = mlx90632_object_from_amb_d(raw, AMB, &prep->d, 25.0, 0.0, MLX90632_FIXED_ITER, &iter, &converged);
+}
+
+static float mlx90632_amb_f(const MLXTempRaw_s *raw, const MLXPrepF_s *k){
+    return raw->ambient_ram_6 * k->amb_scale / (raw->ambient_ram_9 + k->Gb_12 * raw->ambient_ram_6);
+}
+
+static float mlx90632_ambient_from_amb_f(float AMB, const MLXPrepF_s *k){
+    float d = AMB - k->P_R;
+
+    return k->P_O + d * k->inv_PG + k->P_T * (d * d);
+}
+
+static float mlx90632_object_from_amb_f(const MLXTempRaw_s *raw, float AMB, const MLXPrepF_s *k,
+                                        float seed, float tol, int max_iter, int *iter, bool *converged){
+    float Sto_k, TAdut, TK, TAk4, fb_term, prev, g, y, x, root;
+    float TOdut = seed;
+    int i;
+
+    Sto_k = (raw->object_ram_4_7 + raw->object_ram_5_8) * 0.5f * k->amb_scale * k->inv_emiFaHa
+            / (raw->ambient_ram_9 + k->Ka_12 * raw->ambient_ram_6);
+
+    TAdut = (AMB - k->Eb) * k->inv_Ea + 25.0f;
+    TK = TAdut + 273.15f;
+    TAk4 = (TK * TK) * (TK * TK);
+    fb_term = 1.0f + k->Fb * (TAdut - 25.0f);
+
+    *converged = false;
+    for (i = 0; i < max_iter; ++i)
+    {
+        prev = TOdut;
+        g = fb_term + k->Ga * (TOdut - 25.0f);
+        y = Sto_k / g;
+        x = y + TAk4;
+        root = sqrtf(sqrtf(x));
+        TOdut = root - 273.15f - k->Hb;
+        if (fabsf(TOdut - prev) < tol){
+            *converged = true;
+            ++i;
+            break;
+        }
+    }
+    *iter = i;
+
+    return TOdut;
+}
+
+float mlx90632_calc_temp_ambient_f(const MLXTempRaw_s *raw, const MLXPrepared_s *prep){
+    return mlx90632_ambient_from_amb_f(mlx90632_amb_f(raw, &prep->f), &prep->f);
+}
+
+float mlx90632_calc_temp_object_f(const MLXTempRaw_s *raw, const MLXPrepared_s *prep){
+    int iter;
+    bool converged;
+
+    return mlx90632_object_from_amb_f(raw, mlx90632_amb_f(raw, &prep->f), &prep->f,
+                                      25.0f, 0.0f, MLX90632_FIXED_ITER, &iter, &converged);
+}
+
+void mlx90632_calc_temp_f(const MLXTempRaw_s *raw, const MLXPrepared_s *prep, MLXTemp_s *temp){
+    float AMB = mlx90632_amb_f(raw, &prep->f);
+    int iter;
+    bool converged;
+
+    temp->ambient = mlx90632_ambient_from_amb_f(AMB, &prep->f);
+    temp->object = mlx90632_object_from_amb_f(raw, AMB, &prep->f, 25.0f, 0.0f, MLX90632_FIXED_ITER, &iter, &converged);
+}
+
+static uint64_t mlx90632_isqrt64(uint64_t x){
+    uint64_t res = 0;
+    uint64_t bit = (uint64_t)1 << 62;
+
+    while (bit > x)
+        bit >>= 2;
+
+    while (bit != 0){
+        if (x >= res + bit){
+            x -= res + bit;
+            res = (res >> 1) + bit;
+        } else {
+            res >>= 1;
+        }
+        bit >>= 2;
+    }
+    return res;
+}
+
+static int32_t mlx90632_q16_to_mc(int64_t t_q16){
+    return (int32_t)((t_q16 * 1000 + (1 << 15)) >> 16);
+}
+
+/* AMB in Q16: (ram_6 / 12) / (ram_9 + Gb * ram_6 / 12) * 2^19 */
+static int64_t mlx90632_amb_q16(const MLXTempRaw_s *raw, const MLXCalibQ_s *q){
+    int64_t a6 = raw->ambient_ram_6;
+    int64_t vrx = (int64_t)raw->ambient_ram_9 * 12 * 1024 + q->Gb_q10 * a6;
+
+    if (vrx == 0)
+        vrx = 1;
+    return (a6 * ((int64_t)1 << 45)) / vrx;
+}
+
+static int32_t mlx90632_ambient_from_amb_q(int64_t amb_q16, const MLXCalibQ_s *q){
+    int64_t d_q16, lin_q16, ptd_q30, quad_q16, tamb_q16;
+
+    d_q16 = amb_q16 - q->P_R_q8 * 256;
+    lin_q16 = (d_q16 * ((int64_t)1 << 20)) / q->P_G_q20;
+    ptd_q30 = (d_q16 * q->P_T_q44) >> 30;
+    quad_q16 = (ptd_q30 * d_q16) >> 30;
+    tamb_q16 = q->P_O_q8 * 256 + lin_q16 + quad_q16;
+
+    return mlx90632_q16_to_mc(tamb_q16);
+}
+
+static int64_t mlx90632_object_from_amb_q(const MLXTempRaw_s *raw, int64_t amb_q16, const MLXCalibQ_s *q,
+                                          int64_t seed_q16, int64_t tol_q16, int max_iter, int *iter, bool *converged){
+    int64_t a6 = raw->ambient_ram_6;
+    int64_t vrox, sto_q12, tadut_q16, tk_q16, tk2_q8, tak4;
+    int64_t fb_q30, g_q30, x, y, prev, todut_q16 = seed_q16;
+    uint64_t r1, r2;
+    int i;
+
+    //Sto = (S / 12) / VRto * 2^19 with S = (ram_4_7 + ram_5_8) / 2
+    vrox = (int64_t)raw->ambient_ram_9 * 12 * 1024 + q->Ka_q10 * a6;
+    if (vrox == 0)
+        vrox = 1;
+    sto_q12 = ((int64_t)(raw->object_ram_4_7 + raw->object_ram_5_8) * ((int64_t)1 << 40)) / vrox;
+
+    tadut_q16 = ((amb_q16 - q->Eb_q8 * 256) * ((int64_t)1 << 16)) / q->Ea_q16 + ((int64_t)25 << 16);
+    tk_q16 = tadut_q16 + MLX90632_Q_TK0;
+    tk2_q8 = (tk_q16 * tk_q16) >> 24;
+    tak4 = (tk2_q8 * tk2_q8) >> 16;
+
+    fb_q30 = (q->Fb_q36 * (tadut_q16 - ((int64_t)25 << 16))) >> 22;
+
+    *converged = false;
+    for (i = 0; i < max_iter; ++i)
+    {
+        prev = todut_q16;
+        g_q30 = ((int64_t)1 << 30) + ((q->Ga_q36 * (todut_q16 - ((int64_t)25 << 16))) >> 22) + fb_q30;
+        if ((g_q30 >> 10) == 0)
+            g_q30 = (int64_t)1 << 10;
+
+        y = (sto_q12 * q->K_q8) / (g_q30 >> 10);
+        x = y + tak4;
+        if (x <= 0)
+            x = 1;
+
+        r1 = mlx90632_isqrt64((uint64_t)x << 24);     //sqrt(x) in Q12
+        r2 = mlx90632_isqrt64(r1 << 32);              //x^(1/4) in Q22
+        todut_q16 = (int64_t)(r2 >> 6) - MLX90632_Q_TK0 - q->Hb_q16;
+        if (llabs(todut_q16 - prev) < tol_q16){
+            *converged = true;
+            ++i;
+            break;
+        }
+    }
+    *iter = i;
+
+    return todut_q16;
+}
+
+int32_t mlx90632_calc_temp_ambient_q(const MLXTempRaw_s *raw, const MLXPrepared_s *prep){
+    return mlx90632_ambient_from_amb_q(mlx90632_amb_q16(raw, &prep->q), &prep->q);
+}
+
+int32_t mlx90632_calc_temp_object_q(const MLXTempRaw_s *raw, const MLXPrepared_s *prep){
+    int iter;
+    bool converged;
+
+    return mlx90632_q16_to_mc(mlx90632_object_from_amb_q(raw, mlx90632_amb_q16(raw, &prep->q), &prep->q,
+                                                         MLX90632_Q_T25, 0, MLX90632_FIXED_ITER, &iter, &converged));
+}
+
+void mlx90632_calc_temp_q(const MLXTempRaw_s *raw, const MLXPrepared_s *prep, MLXTempQ_s *temp){
+    int64_t amb_q16 = mlx90632_amb_q16(raw, &prep->q);
+    int iter;
+    bool converged;
+
+    temp->ambient_mc = mlx90632_ambient_from_amb_q(amb_q16, &prep->q);
+    temp->object_mc = mlx90632_q16_to_mc(mlx90632_object_from_amb_q(raw, amb_q16, &prep->q,
+                                                                    MLX90632_Q_T25, 0, MLX90632_FIXED_ITER, &iter, &converged));
+}
+
+void mlx90632_calc_temp(const MLXTempRaw_s *raw, const MLXPrepared_s *prep, MLXTemp_s *temp){
+#if MLX_KERNEL == MLX_KERNEL_FLOAT
+    mlx90632_calc_temp_f(raw, prep, temp);
+#elif MLX_KERNEL == MLX_KERNEL_FIXED
+    MLXTempQ_s tq;
+
+    mlx90632_calc_temp_q(raw, prep, &tq);
+    temp->ambient = tq.ambient_mc / 1000.0;
+    temp->object = tq.object_mc / 1000.0;
+#else
+    mlx90632_calc_temp_d(raw, prep, temp);
+#endif
+}
+
+void mlx90632_solver_init(MLXSolver_s *solver, double tolerance, uint8_t max_iter){
+    memset(solver, 0, sizeof(*solver));
+    solver->tolerance = tolerance;
+    solver->max_iter = (max_iter > MLX90632_SOLVER_MAX_ITER) ? MLX90632_SOLVER_MAX_ITER : max_iter;
+    if (solver->max_iter == 0)
+        solver->max_iter = 1;
+}
+
+void mlx90632_solver_invalidate(MLXSolver_s *solver){
+    solver->valid = false;
+}
+
+void mlx90632_solver_get_stats(const MLXSolver_s *solver, MLXSolverStats_s *stats){
+    *stats = solver->stats;
+}
+
+void mlx90632_solver_reset_stats(MLXSolver_s *solver){
+    memset(&solver->stats, 0, sizeof(solver->stats));
+}
+
+void mlx90632_calc_temp_warm(const MLXTempRaw_s *raw, const MLXPrepared_s *prep, MLXSolver_s *solver, MLXTemp_s *temp){
+    double seed = solver->valid ? solver->object : 25.0;
+    int iter;
+    bool converged;
+
+#if MLX_KERNEL == MLX_KERNEL_FLOAT
+    float AMB = mlx90632_amb_f(raw, &prep->f);
+
+    temp->ambient = mlx90632_ambient_from_amb_f(AMB, &prep->f);
+    temp->object = mlx90632_object_from_amb_f(raw, AMB, &prep->f, (float)seed, (float)solver->tolerance,
+                                              solver->max_iter, &iter, &converged);
+#elif MLX_KERNEL == MLX_KERNEL_FIXED
+    int64_t amb_q16 = mlx90632_amb_q16(raw, &prep->q);
+    int64_t todut_q16;
+
+    temp->ambient = mlx90632_ambient_from_amb_q(amb_q16, &prep->q) / 1000.0;
+    todut_q16 = mlx90632_object_from_amb_q(raw, amb_q16, &prep->q, llround(ldexp(seed, MLX90632_Q_TEMP)),
+                                           llround(ldexp(solver->tolerance, MLX90632_Q_TEMP)),
+                                           solver->max_iter, &iter, &converged);
+    temp->object = mlx90632_q16_to_mc(todut_q16) / 1000.0;
+#else
+    double AMB = mlx90632_amb_d(raw, &prep->d);
+
+    temp->ambient = mlx90632_ambient_from_amb_d(AMB, &prep->d);
+    temp->object = mlx90632_object_from_amb_d(raw, AMB, &prep->d, seed, solver->tolerance,
+                                              solver->max_iter, &iter, &converged);
+#endif
+
+    //a NaN result (e.g. sensor disconnected) must not seed the next sample
+    solver->valid = (temp->object == temp->object);
+    solver->object = temp->object;
+
+    solver->stats.samples++;
+    solver->stats.iterations += iter;
+    solver->stats.hist[iter]++;
+    if ((uint32_t)iter > solver->stats.max)
+        solver->stats.max = iter;
+    //a sample converging on its last allowed iteration did reach the tolerance
+    if (!converged)
+        solver->stats.limit_reached++;
+}
+
+void mlx90632_calc_temp_kernel(const MLXTempRaw_s *raw, MLXTemp_s *temp){
+    MLXPrepared_s prep;
+
+    //one consistent calibration for the whole sample
+    mlx90632_kernel_snapshot(&prep);
+#if MLX_SOLVER == MLX_SOLVER_WARM
+    mlx90632_calc_temp_warm(raw, &prep, &MLX_SV, temp);
+#else
+    mlx90632_calc_temp(raw, &prep, temp);
+#endif
+}
+
+///@}
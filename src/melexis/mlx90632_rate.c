@@ -0,0 +1,118 @@
+/******************************************************************************
+ * Copyright (c) 2025 Marconatale Parise.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * You may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************/
+/**
+ * @file mlx90632_rate.c
+ * @brief adaptive refresh rate controller
+ *
+ * Time differences are computed on uint32_t, so the controller keeps working across the
+ * wrap of the ms counter.
+ *
+ */
+#include <string.h>
+#include "mlx90632_rate.h"
+
+static const MLXRateConfig_s mlx90632_rate_default = {
+    .min_rate = MLX90632_MEAS_HZ_HALF,
+    .max_rate = MLX90632_MEAS_HZ_8,
+    .window_ms = MLX90632_RATE_WINDOW_MS,
+    .up_milli_per_s = MLX90632_RATE_UP_MILLI,
+    .down_milli_per_s = MLX90632_RATE_DOWN_MILLI,
+    .calm_windows = MLX90632_RATE_CALM_WINDOWS,
+    .hold_ms = MLX90632_RATE_HOLD_MS,
+    .min_change_ms = MLX90632_RATE_MIN_CHANGE_MS,
+    .max_changes = MLX90632_RATE_MAX_CHANGES,
+};
+
+/* EEPROM wear limits, common to steps up and down */
+static bool mlx90632_rate_allowed(MLXRate_s *rc, uint32_t now_ms){
+    if (((rc->cfg.max_changes == 0) || (rc->ups + rc->downs < rc->cfg.max_changes)) &&
+        (now_ms - rc->changed_ms >= rc->cfg.min_change_ms))
+        return true;
+
+    rc->blocked++;
+    return false;
+}
+
+void mlx90632_rate_init(MLXRate_s *rc, const MLXRateConfig_s *cfg, mlx90632_meas_t rate){
+    memset(rc, 0, sizeof(*rc));
+    rc->cfg = (cfg != NULL) ? *cfg : mlx90632_rate_default;
+    rc->rate = MAX(MIN(rate, rc->cfg.max_rate), rc->cfg.min_rate);
+}
+
+mlx90632_meas_t mlx90632_rate_update(MLXRate_s *rc, double object, uint32_t now_ms){
+    uint32_t elapsed;
+    double slope;
+
+    if (!rc->primed){
+        rc->primed = true;
+        rc->ref_object = object;
+        rc->ref_ms = now_ms;
+        rc->changed_ms = now_ms;
+        return rc->rate;
+    }
+
+    elapsed = now_ms - rc->ref_ms;
+    if (elapsed < rc->cfg.window_ms)
+        return rc->rate;
+
+    slope = fabs(object - rc->ref_object) * 1000.0 / (double)elapsed;
+    rc->slope_milli = (slope * 1000.0 >= (double)UINT32_MAX) ? UINT32_MAX : (uint32_t)(slope * 1000.0);
+    rc->ref_object = object;
+    rc->ref_ms = now_ms;
+
+    if (rc->slope_milli > rc->cfg.up_milli_per_s){
+        rc->calm = 0;
+        if ((rc->rate != rc->cfg.max_rate) && mlx90632_rate_allowed(rc, now_ms)){
+            rc->rate = rc->cfg.max_rate;
+            rc->changed_ms = now_ms;
+            rc->ups++;
+        }
+        return rc->rate;
+    }
+
+    if (rc->slope_milli >= rc->cfg.down_milli_per_s){
+        rc->calm = 0;
+        return rc->rate;
+    }
+
+    if (rc->calm < rc->cfg.calm_windows)
+        rc->calm++;
+    if ((rc->calm >= rc->cfg.calm_windows) && (rc->rate > rc->cfg.min_rate) &&
+        (now_ms - rc->changed_ms >= rc->cfg.hold_ms) && mlx90632_rate_allowed(rc, now_ms)){
+        rc->rate = (mlx90632_meas_t)(rc->rate - 1);
+        rc->changed_ms = now_ms;
+        rc->calm = 0;
+        rc->downs++;
+    }
+    return rc->rate;
+}
+
+void mlx90632_rate_sync(MLXRate_s *rc, mlx90632_meas_t rate, uint32_t now_ms){
+    rc->rate = rate;
+    rc->changed_ms = now_ms;
+    rc->calm = 0;
+    rc->syncs++;
+}
+
+void mlx90632_rate_get_stats(const MLXRate_s *rc, MLXRateStats_s *stats){
+    stats->rate = rc->rate;
+    stats->slope_milli = rc->slope_milli;
+    stats->ups = rc->ups;
+    stats->downs = rc->downs;
+    stats->blocked = rc->blocked;
+    stats->syncs = rc->syncs;
+}
@@ -0,0 +1,75 @@
+/******************************************************************************
+ * Copyright (c) 2025 Marconatale Parise.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * You may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************/
+/**
+ * @file mlx90632_ring.c
+ * @brief Lock-free single-producer/single-consumer ring of raw melexis samples
+ *
+ * This implementation file provides the ring used to move raw samples from the
+ * acquisition thread to the processing thread.
+ * 
+ * @author Marconatale Parise
+ * @date 09 June 2025
+ *
+ */
+#include "mlx90632_ring.h"
+
+void mlx90632_ring_init(MLXRing_s *ring){
+    atomic_set(&ring->head, 0);
+    atomic_set(&ring->tail, 0);
+    atomic_set(&ring->overruns, 0);
+    atomic_set(&ring->high_water, 0);
+}
+
+bool mlx90632_ring_put(MLXRing_s *ring, const MLXSample_s *sample){
+    uint32_t head = (uint32_t)atomic_get(&ring->head);
+    uint32_t tail = (uint32_t)atomic_get(&ring->tail);
+    uint32_t used = head - tail;
+
+    if (used >= MLX90632_RING_SIZE){
+        atomic_inc(&ring->overruns);
+        return false;
+    }
+
+    ring->buf[head & MLX90632_RING_MASK] = *sample;
+    //publish the slot only after it is written
+    atomic_set(&ring->head, (atomic_val_t)(head + 1));
+
+    if ((used + 1) > (uint32_t)atomic_get(&ring->high_water))
+        atomic_set(&ring->high_water, (atomic_val_t)(used + 1));
+
+    return true;
+}
+
+bool mlx90632_ring_get(MLXRing_s *ring, MLXSample_s *sample){
+    uint32_t tail = (uint32_t)atomic_get(&ring->tail);
+    uint32_t head = (uint32_t)atomic_get(&ring->head);
+
+    if (head == tail)
+        return false;
+
+    *sample = ring->buf[tail & MLX90632_RING_MASK];
+    //release the slot only after it is copied
+    atomic_set(&ring->tail, (atomic_val_t)(tail + 1));
+
+    return true;
+}
+
+void mlx90632_ring_get_stats(MLXRing_s *ring, MLXRingStats_s *stats){
+    stats->count = (uint32_t)atomic_get(&ring->head) - (uint32_t)atomic_get(&ring->tail);
+    stats->overruns = (uint32_t)atomic_get(&ring->overruns);
+    stats->high_water = (uint32_t)atomic_get(&ring->high_water);
+}
@@ -0,0 +1,140 @@
+/******************************************************************************
+ * Copyright (c) 2025 Marconatale Parise.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * You may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************/
+/**
+ * @file mlx90632_rolling.c
+ * @brief rolling statistics of ambient and object temperature
+ *
+ * Mean and m2 are double: at 64 Hz one hour is ~230000 samples, and the naive sum of squares
+ * in float would lose the variance of a 37 degC signal entirely.
+ *
+ */
+#include <string.h>
+#include "mlx90632_rolling.h"
+
+static void mlx90632_rolling_agg_add(MLXRollingAgg_s *agg, double x){
+    double delta;
+
+    if (agg->count == 0){
+        agg->min = (float)x;
+        agg->max = (float)x;
+    } else {
+        agg->min = MIN(agg->min, (float)x);
+        agg->max = MAX(agg->max, (float)x);
+    }
+    agg->count++;
+    delta = x - agg->mean;
+    agg->mean += delta / agg->count;
+    agg->m2 += delta * (x - agg->mean);
+}
+
+/* Pairwise merge of two partial aggregates (Chan et al.) */
+static void mlx90632_rolling_agg_merge(MLXRollingAgg_s *dst, const MLXRollingAgg_s *src){
+    double delta, n;
+
+    if (src->count == 0)
+        return;
+    if (dst->count == 0){
+        *dst = *src;
+        return;
+    }
+
+    n = (double)dst->count + (double)src->count;
+    delta = src->mean - dst->mean;
+    dst->mean += delta * src->count / n;
+    dst->m2 += src->m2 + delta * delta * dst->count * src->count / n;
+    dst->min = MIN(dst->min, src->min);
+    dst->max = MAX(dst->max, src->max);
+    dst->count += src->count;
+}
+
+static void mlx90632_rolling_summary(const MLXRollingAgg_s *agg, MLXRollingSummary_s *summary){
+    memset(summary, 0, sizeof(*summary));
+    if (agg->count == 0)
+        return;
+
+    summary->count = agg->count;
+    summary->min = agg->min;
+    summary->max = agg->max;
+    summary->mean = agg->mean;
+    if (agg->count > 1)
+        summary->variance = agg->m2 / (agg->count - 1);
+}
+
+/* Move the current bucket up to now, clearing the buckets that left the window */
+static void mlx90632_rolling_advance(MLXRollingWindow_s *window, uint32_t now_ms){
+    uint32_t steps, i;
+
+    steps = (now_ms - window->start_ms) / window->bucket_ms;
+    if (steps == 0)
+        return;
+
+    for (i = 0; i < MIN(steps, (uint32_t)MLX90632_ROLLING_BUCKETS); i++){
+        window->current = (uint8_t)((window->current + 1) % MLX90632_ROLLING_BUCKETS);
+        memset(&window->bucket[window->current], 0, sizeof(window->bucket[0]));
+    }
+    window->start_ms += steps * window->bucket_ms;
+}
+
+int mlx90632_rolling_init(MLXRolling_s *rolling, const uint32_t *spans_ms, uint8_t count, uint32_t now_ms){
+    uint8_t i;
+
+    memset(rolling, 0, sizeof(*rolling));
+    rolling->count = MIN(count, MLX90632_ROLLING_MAX_WINDOWS);
+    for (i = 0; i < rolling->count; i++){
+        if (spans_ms[i] < MLX90632_ROLLING_BUCKETS)
+            return -EINVAL;
+        rolling->window[i].span_ms = spans_ms[i];
+        rolling->window[i].bucket_ms = spans_ms[i] / MLX90632_ROLLING_BUCKETS;
+        rolling->window[i].start_ms = now_ms;
+    }
+    return 0;
+}
+
+void mlx90632_rolling_add(MLXRolling_s *rolling, const MLXTemp_s *temp, uint32_t now_ms){
+    MLXRollingWindow_s *window;
+    uint8_t i;
+
+    for (i = 0; i < rolling->count; i++){
+        window = &rolling->window[i];
+        mlx90632_rolling_advance(window, now_ms);
+        mlx90632_rolling_agg_add(&window->bucket[window->current].ambient, temp->ambient);
+        mlx90632_rolling_agg_add(&window->bucket[window->current].object, temp->object);
+    }
+}
+
+int mlx90632_rolling_get(MLXRolling_s *rolling, uint8_t index, uint32_t now_ms,
+                         MLXRollingSummary_s *ambient, MLXRollingSummary_s *object){
+    MLXRollingWindow_s *window;
+    MLXRollingAgg_s amb = {0}, obj = {0};
+    uint8_t i;
+
+    if (index >= rolling->count)
+        return -EINVAL;
+
+    window = &rolling->window[index];
+    mlx90632_rolling_advance(window, now_ms);
+    for (i = 0; i < MLX90632_ROLLING_BUCKETS; i++){
+        mlx90632_rolling_agg_merge(&amb, &window->bucket[i].ambient);
+        mlx90632_rolling_agg_merge(&obj, &window->bucket[i].object);
+    }
+
+    if (ambient != NULL)
+        mlx90632_rolling_summary(&amb, ambient);
+    if (object != NULL)
+        mlx90632_rolling_summary(&obj, object);
+    return 0;
+}
@@ -0,0 +1,167 @@
+/******************************************************************************
+ * Copyright (c) 2025 Marconatale Parise.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * You may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************/
+/**
+ * @file mlx90632_sched.c
+ * @brief scheduler that interleaves conversions of several melexis sensors
+ *
+ * The scheduler is used by one thread only, no lock is taken. Sensor access goes through
+ * mlx90632_sensor_start() and mlx90632_sensor_poll(), which lock the sensor instance.
+ *
+ */
+#include "mlx90632_sched.h"
+#include "mlx90632.h"
+#include <string.h>
+
+static uint64_t mlx90632_sched_now_us(void){
+    return k_ticks_to_us_floor64(k_uptime_ticks());
+}
+
+/* SOC on a sensor and compute when to check it, a failed start is retried one conversion later */
+static int mlx90632_sched_start(MLXSchedSensor_s *s, uint64_t now){
+    int ret;
+
+    ret = mlx90632_sensor_start(s->dev);
+    if (ret < 0){
+        s->errors++;
+        s->started = false;
+        s->due_us = now + s->conv_time_us;
+        return ret;
+    }
+
+    s->started = true;
+    s->start_us = now;
+    s->due_us = now + s->conv_time_us - s->conv_time_us / MLX90632_WAKEUP_MARGIN_DIV;
+    return 0;
+}
+
+int mlx90632_sched_init(MLXSched_s *sched, const struct device *const *devs, uint8_t count,
+                        MLXSchedCallback_t callback, void *user){
+    uint8_t i;
+
+    if ((count == 0) || (count > MLX90632_SCHED_MAX_SENSORS))
+        return -EINVAL;
+
+    memset(sched, 0, sizeof(*sched));
+    for (i = 0; i < count; i++){
+        if (!device_is_ready(devs[i]))
+            return -ENODEV;
+        sched->sensor[i].dev = devs[i];
+        sched->sensor[i].conv_time_us = mlx90632_sensor_conv_time_us(devs[i]);
+    }
+    sched->count = count;
+    sched->callback = callback;
+    sched->user = user;
+    sched->t0_us = mlx90632_sched_now_us();
+    return 0;
+}
+
+int mlx90632_sched_step(MLXSched_s *sched){
+    MLXSchedSensor_s *s, *next = NULL;
+    uint64_t now = mlx90632_sched_now_us();
+    uint32_t gap, poll_interval;
+    uint8_t i;
+    int ret;
+
+    //start idle sensors, then pick the one due first
+    for (i = 0; i < sched->count; i++){
+        s = &sched->sensor[i];
+        if (!s->started && (now >= s->due_us))
+            mlx90632_sched_start(s, now);
+        if ((next == NULL) || (s->due_us < next->due_us))
+            next = s;
+    }
+    s = next;
+
+    if (s->due_us > now){
+        k_usleep((int32_t)(s->due_us - now));
+        now = mlx90632_sched_now_us();
+    }
+    if (!s->started)
+        return 0;
+
+    s->polls++;
+    ret = mlx90632_sensor_poll(s->dev);
+    if (ret < 0){
+        s->errors++;
+        s->started = false;
+        s->due_us = now + s->conv_time_us;
+        return ret;
+    }
+
+    if (ret == 0){
+        if (now - s->start_us > (uint64_t)s->conv_time_us * MLX90632_SCHED_TIMEOUT_CONV){
+            s->timeouts++;
+            s->started = false;
+            s->due_us = now;
+        } else {
+            poll_interval = MAX(s->conv_time_us / MLX90632_POLL_INTERVAL_DIV, MLX90632_MIN_POLL_INTERVAL);
+            s->due_us = now + poll_interval;
+        }
+        return 0;
+    }
+
+    if (s->last_sample_us != 0){
+        gap = (uint32_t)(now - s->last_sample_us);
+        s->max_gap_us = MAX(s->max_gap_us, gap);
+    }
+    s->last_sample_us = now;
+    s->samples++;
+
+    //restart before the callback, the sensor converts while the sample is used
+    mlx90632_sched_start(s, now);
+    if (sched->callback != NULL)
+        sched->callback(s->dev, sched->user);
+    return 1;
+}
+
+void mlx90632_sched_get_stats(const MLXSched_s *sched, MLXSchedStats_s *stats){
+    const MLXSchedSensor_s *s;
+    uint64_t now = mlx90632_sched_now_us();
+    uint64_t elapsed = now - sched->t0_us;
+    uint8_t i;
+
+    memset(stats, 0, sizeof(*stats));
+    stats->count = sched->count;
+    stats->elapsed_ms = (uint32_t)(elapsed / 1000U);
+    for (i = 0; i < sched->count; i++){
+        s = &sched->sensor[i];
+        stats->samples += s->samples;
+        stats->sensor[i].samples = s->samples;
+        stats->sensor[i].polls = s->polls;
+        stats->sensor[i].timeouts = s->timeouts;
+        stats->sensor[i].errors = s->errors;
+        stats->sensor[i].max_gap_us = s->max_gap_us;
+        stats->sensor[i].staleness_us = (s->last_sample_us != 0) ? (uint32_t)(now - s->last_sample_us) : UINT32_MAX;
+    }
+    if (elapsed > 0)
+        stats->samples_per_sec_milli = (uint32_t)((uint64_t)stats->samples * 1000000000U / elapsed);
+}
+
+void mlx90632_sched_reset_stats(MLXSched_s *sched){
+    MLXSchedSensor_s *s;
+    uint8_t i;
+
+    for (i = 0; i < sched->count; i++){
+        s = &sched->sensor[i];
+        s->samples = 0;
+        s->polls = 0;
+        s->timeouts = 0;
+        s->errors = 0;
+        s->max_gap_us = 0;
+    }
+    sched->t0_us = mlx90632_sched_now_us();
+}
@@ -0,0 +1,643 @@
+/******************************************************************************
+ * Copyright (c) 2025 Marconatale Parise.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * You may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************/
+/**
+ * @file mlx90632_sensor.c
+ * @brief Zephyr sensor driver of the melexis sensor
+ *
+ * One device per okay devicetree instance. Register access goes through the instance
+ * i2c_dt_spec, the math reuses the pure library functions (mlx90632_decodeCalib(),
+ * mlx90632_prepare(), mlx90632_decodeTempRaw(), mlx90632_calc_temp()) on per-instance state,
+ * so the globals of the library are not touched.
+ *
+ * Instance data is protected by a mutex: sample fetch, attribute set, trigger set and the
+ * trigger work may run from different threads.
+ *
+ * mlx90632_read_async() runs the measurement as a chain of stages on a delayable work item:
+ * every stage queues one i2c transfer with i2c_transfer_cb() and returns, the transfer
+ * completion reschedules the work for the next stage. The conversion wait and the status
+ * polls are work delays, so no thread blocks during a measurement. A bus driver without
+ * callback support (-ENOSYS, or CONFIG_I2C_CALLBACK not set) runs the transfer in the work
+ * item instead. The lock is not held between stages, the async_busy flag keeps the blocking
+ * API and the trigger off the sensor until the completion callback.
+ *
+ */
+#define DT_DRV_COMPAT melexis_mlx90632
+
+#include <zephyr/kernel.h>
+#include <zephyr/device.h>
+#include <zephyr/drivers/i2c.h>
+#include <zephyr/drivers/sensor.h>
+#include <zephyr/logging/log.h>
+#include "mlx90632.h"
+#include "mlx90632_kernel.h"
+#include "mlx90632_sensor.h"
+
+LOG_MODULE_REGISTER(mlx90632_sensor, CONFIG_SENSOR_LOG_LEVEL);
+
+enum mlx90632_async_stage {
+    MLX90632_ASYNC_CLEAR,       /**< read status to clear data ready */
+    MLX90632_ASYNC_CLEAR_WRITE, /**< write status with data ready cleared */
+    MLX90632_ASYNC_SOC,         /**< write control with SOC */
+    MLX90632_ASYNC_CONVERTING,  /**< wait the conversion time */
+    MLX90632_ASYNC_STATUS,      /**< read status */
+    MLX90632_ASYNC_STATUS_DONE, /**< check data ready, read the RAM window if set */
+    MLX90632_ASYNC_RAM_DONE,    /**< convert the sample and complete */
+};
+
+struct mlx90632_sensor_config {
+    struct i2c_dt_spec i2c;
+    uint16_t emissivity_milli;
+};
+
+struct mlx90632_sensor_data {
+    const struct device *dev;
+    struct k_mutex lock;
+    MLXCalib_s calib;
+    MLXPrepared_s prep;
+    MLXSolver_s solver;
+    MLXTempRaw_s raw;
+    MLXTemp_s temp;
+    double emissivity;
+    uint32_t conv_time_us;
+    struct k_timer timer;
+    struct k_work work;
+    sensor_trigger_handler_t handler;
+    const struct sensor_trigger *trigger;
+    uint16_t reg_ctrl;          /**< control register as last written by set mode */
+    /* mlx90632_read_async() state, buffers must live until the transfer completes */
+    bool async_busy;
+    enum mlx90632_async_stage async_stage;
+    int async_result;           /**< result of the last transfer */
+    int async_tries;
+    int async_cycle_pos;
+    MLXAsyncCallback_t async_cb;
+    void *async_user;
+    struct k_work_delayable async_work;
+    struct i2c_msg async_msgs[2];
+    uint8_t async_tx[4];
+    uint16_t async_rx[MLX90632_RAM_BLOCK_LEN];
+};
+
+static int mlx90632_sensor_read_block(const struct device *dev, uint16_t reg, uint16_t *value, uint16_t len){
+    const struct mlx90632_sensor_config *cfg = dev->config;
+    uint8_t reg_write[2];
+    uint16_t i;
+    int ret;
+
+    reg_write[0] = (reg >> 8); //MSB
+    reg_write[1] = (reg & 0xFF); //LSB
+
+    ret = i2c_write_read_dt(&cfg->i2c, reg_write, sizeof(reg_write), value, (size_t)len * 2);
+    if (ret)
+        return ret;
+
+    //sensor sends MSB first for each word
+    for (i = 0; i < len; i++)
+        value[i] = (value[i] >> 8) | ((value[i] & 0x00FF) << 8);
+    return 0;
+}
+
+static int mlx90632_sensor_read(const struct device *dev, uint16_t reg, uint16_t *value){
+    return mlx90632_sensor_read_block(dev, reg, value, 1);
+}
+
+static int mlx90632_sensor_write(const struct device *dev, uint16_t reg, uint16_t value){
+    const struct mlx90632_sensor_config *cfg = dev->config;
+    uint8_t frame[4];
+
+    frame[0] = (reg >> 8); //MSB
+    frame[1] = (reg & 0xFF); //LSB
+    frame[2] = (value >> 8); //MSB
+    frame[3] = (value & 0xFF); //LSB
+
+    return i2c_write_dt(&cfg->i2c, frame, sizeof(frame));
+}
+
+static int mlx90632_sensor_set_mode(const struct device *dev, uint16_t mode){
+    struct mlx90632_sensor_data *data = dev->data;
+    uint16_t reg_ctrl;
+    int ret;
+
+    ret = mlx90632_sensor_read(dev, MLX90632_REG_CTRL, &reg_ctrl);
+    if (ret)
+        return ret;
+
+    reg_ctrl = (reg_ctrl & ~MLX90632_CFG_PWR_MASK) | mode;
+    ret = mlx90632_sensor_write(dev, MLX90632_REG_CTRL, reg_ctrl);
+    if (ret == 0)
+        data->reg_ctrl = reg_ctrl;
+    return ret;
+}
+
+/* Read and convert the RAM window of cycle position 1 or 2, lock held */
+static int mlx90632_sensor_read_sample(const struct device *dev, int cycle_pos){
+    struct mlx90632_sensor_data *data = dev->data;
+    uint16_t ram[MLX90632_RAM_BLOCK_LEN];
+    int ret;
+
+    ret = mlx90632_sensor_read_block(dev, MLX90632_RAM_BLOCK_START, ram, MLX90632_RAM_BLOCK_LEN);
+    if (ret)
+        return ret;
+
+    mlx90632_decodeTempRaw(cycle_pos, ram, &data->raw);
+#if MLX_SOLVER == MLX_SOLVER_WARM
+    mlx90632_calc_temp_warm(&data->raw, &data->prep, &data->solver, &data->temp);
+#else
+    mlx90632_calc_temp(&data->raw, &data->prep, &data->temp);
+#endif
+    return 0;
+}
+
+/* Clear data ready, lock held */
+static int mlx90632_sensor_clear_ready(const struct device *dev){
+    uint16_t reg_status;
+    int ret;
+
+    ret = mlx90632_sensor_read(dev, MLX90632_REG_STATUS, &reg_status);
+    if (ret)
+        return ret;
+    return mlx90632_sensor_write(dev, MLX90632_REG_STATUS, reg_status & ~MLX90632_STAT_DATA_RDY);
+}
+
+/* Clear data ready and start a conversion in sleeping step mode, lock held */
+static int mlx90632_sensor_start_locked(const struct device *dev){
+    uint16_t reg_ctrl;
+    int ret;
+
+    ret = mlx90632_sensor_clear_ready(dev);
+    if (ret)
+        return ret;
+
+    ret = mlx90632_sensor_read(dev, MLX90632_REG_CTRL, &reg_ctrl);
+    if (ret)
+        return ret;
+    return mlx90632_sensor_write(dev, MLX90632_REG_CTRL, reg_ctrl | MLX90632_CFG_SOC_MASK);
+}
+
+/* Check data ready once and read the sample if set: 1 new sample, 0 not ready, lock held */
+static int mlx90632_sensor_poll_locked(const struct device *dev){
+    uint16_t reg_status;
+    int cycle_pos, ret;
+
+    ret = mlx90632_sensor_read(dev, MLX90632_REG_STATUS, &reg_status);
+    if (ret)
+        return ret;
+    if (!(reg_status & MLX90632_STAT_DATA_RDY))
+        return 0;
+
+    cycle_pos = (int)(reg_status & (uint16_t)MLX90632_STAT_CYCLE_POS) >> 2;
+    if ((cycle_pos != 1) && (cycle_pos != 2))
+        return -EIO;
+
+    ret = mlx90632_sensor_read_sample(dev, cycle_pos);
+    return (ret == 0) ? 1 : ret;
+}
+
+/* One measurement in sleeping step mode: SOC, sleep until just before data ready, poll, lock held */
+static int mlx90632_sensor_measure(const struct device *dev){
+    struct mlx90632_sensor_data *data = dev->data;
+    int tries = MLX90632_MAX_NUMBER_MESUREMENT_READ_TRIES;
+    uint32_t poll_interval;
+    int ret;
+
+    ret = mlx90632_sensor_start_locked(dev);
+    if (ret)
+        return ret;
+
+    k_usleep(data->conv_time_us - data->conv_time_us / MLX90632_WAKEUP_MARGIN_DIV);
+
+    poll_interval = MAX(data->conv_time_us / MLX90632_POLL_INTERVAL_DIV, MLX90632_MIN_POLL_INTERVAL);
+    while (tries-- > 0){
+        ret = mlx90632_sensor_poll_locked(dev);
+        if (ret != 0)
+            return (ret > 0) ? 0 : ret;
+        k_usleep(poll_interval);
+    }
+
+    return -ETIMEDOUT;
+}
+
+int mlx90632_sensor_start(const struct device *dev){
+    struct mlx90632_sensor_data *data = dev->data;
+    int ret;
+
+    k_mutex_lock(&data->lock, K_FOREVER);
+    ret = ((data->handler != NULL) || data->async_busy) ? -EBUSY : mlx90632_sensor_start_locked(dev);
+    k_mutex_unlock(&data->lock);
+
+    return ret;
+}
+
+int mlx90632_sensor_poll(const struct device *dev){
+    struct mlx90632_sensor_data *data = dev->data;
+    int ret;
+
+    k_mutex_lock(&data->lock, K_FOREVER);
+    ret = ((data->handler != NULL) || data->async_busy) ? -EBUSY : mlx90632_sensor_poll_locked(dev);
+    k_mutex_unlock(&data->lock);
+
+    return ret;
+}
+
+uint32_t mlx90632_sensor_conv_time_us(const struct device *dev){
+    const struct mlx90632_sensor_data *data = dev->data;
+
+    return data->conv_time_us;
+}
+
+static void mlx90632_sensor_work(struct k_work *work){
+    struct mlx90632_sensor_data *data = CONTAINER_OF(work, struct mlx90632_sensor_data, work);
+    const struct device *dev = data->dev;
+    sensor_trigger_handler_t handler;
+    const struct sensor_trigger *trigger;
+    uint16_t reg_status;
+    int cycle_pos;
+    bool ready = false;
+
+    k_mutex_lock(&data->lock, K_FOREVER);
+    handler = data->handler;
+    trigger = data->trigger;
+    if ((handler != NULL) && (mlx90632_sensor_read(dev, MLX90632_REG_STATUS, &reg_status) == 0)){
+        //continuous mode: new data when data ready is set, the cycle position selects the RAM bank
+        cycle_pos = (int)(reg_status & (uint16_t)MLX90632_STAT_CYCLE_POS) >> 2;
+        if ((reg_status & MLX90632_STAT_DATA_RDY) && ((cycle_pos == 1) || (cycle_pos == 2))){
+            ready = (mlx90632_sensor_read_sample(dev, cycle_pos) == 0);
+            //cleared only once the RAM words are read
+            if (ready)
+                (void)mlx90632_sensor_write(dev, MLX90632_REG_STATUS, reg_status & ~MLX90632_STAT_DATA_RDY);
+        }
+    }
+    k_mutex_unlock(&data->lock);
+
+    if (ready)
+        handler(dev, trigger);
+}
+
+static void mlx90632_sensor_timer(struct k_timer *timer){
+    struct mlx90632_sensor_data *data = CONTAINER_OF(timer, struct mlx90632_sensor_data, timer);
+
+    k_work_submit(&data->work);
+}
+
+/* Transfer completion, may run in interrupt context: store the result and run the next stage */
+static void mlx90632_sensor_async_done(const struct device *bus, int result, void *user){
+    struct mlx90632_sensor_data *data = user;
+
+    data->async_result = result;
+    k_work_reschedule(&data->async_work, K_NO_WAIT);
+}
+
+/* Queue the transfer of the async messages, blocking only when the bus has no callback support */
+static int mlx90632_sensor_async_xfer(const struct device *dev, uint8_t num_msgs){
+    const struct mlx90632_sensor_config *cfg = dev->config;
+    struct mlx90632_sensor_data *data = dev->data;
+    int ret;
+
+#ifdef CONFIG_I2C_CALLBACK
+    ret = i2c_transfer_cb(cfg->i2c.bus, data->async_msgs, num_msgs, cfg->i2c.addr,
+                          mlx90632_sensor_async_done, data);
+    if (ret != -ENOSYS)
+        return ret;
+#endif
+    ret = i2c_transfer(cfg->i2c.bus, data->async_msgs, num_msgs, cfg->i2c.addr);
+    mlx90632_sensor_async_done(cfg->i2c.bus, ret, data);
+    return 0;
+}
+
+static int mlx90632_sensor_async_read(const struct device *dev, uint16_t reg, uint16_t len){
+    struct mlx90632_sensor_data *data = dev->data;
+
+    data->async_tx[0] = (reg >> 8); //MSB
+    data->async_tx[1] = (reg & 0xFF); //LSB
+    data->async_msgs[0].buf = data->async_tx;
+    data->async_msgs[0].len = 2;
+    data->async_msgs[0].flags = I2C_MSG_WRITE;
+    data->async_msgs[1].buf = (uint8_t *)data->async_rx;
+    data->async_msgs[1].len = (uint32_t)len * 2;
+    data->async_msgs[1].flags = I2C_MSG_RESTART | I2C_MSG_READ | I2C_MSG_STOP;
+    return mlx90632_sensor_async_xfer(dev, 2);
+}
+
+static int mlx90632_sensor_async_write(const struct device *dev, uint16_t reg, uint16_t value){
+    struct mlx90632_sensor_data *data = dev->data;
+
+    data->async_tx[0] = (reg >> 8); //MSB
+    data->async_tx[1] = (reg & 0xFF); //LSB
+    data->async_tx[2] = (value >> 8); //MSB
+    data->async_tx[3] = (value & 0xFF); //LSB
+    data->async_msgs[0].buf = data->async_tx;
+    data->async_msgs[0].len = 4;
+    data->async_msgs[0].flags = I2C_MSG_WRITE | I2C_MSG_STOP;
+    return mlx90632_sensor_async_xfer(dev, 1);
+}
+
+/* First received word, the sensor sends MSB first */
+static uint16_t mlx90632_sensor_async_word(const struct mlx90632_sensor_data *data){
+    return (data->async_rx[0] >> 8) | ((data->async_rx[0] & 0x00FF) << 8);
+}
+
+/* Convert the RAM window read by the chain, lock held */
+static void mlx90632_sensor_async_convert(struct mlx90632_sensor_data *data){
+    uint16_t i;
+
+    for (i = 0; i < MLX90632_RAM_BLOCK_LEN; i++)
+        data->async_rx[i] = (data->async_rx[i] >> 8) | ((data->async_rx[i] & 0x00FF) << 8);
+
+    mlx90632_decodeTempRaw(data->async_cycle_pos, data->async_rx, &data->raw);
+#if MLX_SOLVER == MLX_SOLVER_WARM
+    mlx90632_calc_temp_warm(&data->raw, &data->prep, &data->solver, &data->temp);
+#else
+    mlx90632_calc_temp(&data->raw, &data->prep, &data->temp);
+#endif
+}
+
+static void mlx90632_sensor_async_complete(struct mlx90632_sensor_data *data, int result){
+    MLXAsyncCallback_t cb;
+    void *user;
+
+    k_mutex_lock(&data->lock, K_FOREVER);
+    if (result == 0)
+        mlx90632_sensor_async_convert(data);
+    cb = data->async_cb;
+    user = data->async_user;
+    data->async_busy = false;
+    k_mutex_unlock(&data->lock);
+
+    if (result)
+        LOG_ERR("%s: async measurement failed (%d)", data->dev->name, result);
+    if (cb != NULL)
+        cb(data->dev, result, user);
+}
+
+static void mlx90632_sensor_async_work(struct k_work *work){
+    struct k_work_delayable *dwork = k_work_delayable_from_work(work);
+    struct mlx90632_sensor_data *data = CONTAINER_OF(dwork, struct mlx90632_sensor_data, async_work);
+    const struct device *dev = data->dev;
+    uint32_t poll_interval;
+    uint16_t reg_status;
+    int ret = data->async_result;
+
+    data->async_result = 0;
+    if (ret){
+        mlx90632_sensor_async_complete(data, ret);
+        return;
+    }
+
+    switch (data->async_stage){
+    case MLX90632_ASYNC_CLEAR:
+        data->async_stage = MLX90632_ASYNC_CLEAR_WRITE;
+        ret = mlx90632_sensor_async_read(dev, MLX90632_REG_STATUS, 1);
+        break;
+    case MLX90632_ASYNC_CLEAR_WRITE:
+        reg_status = mlx90632_sensor_async_word(data);
+        data->async_stage = MLX90632_ASYNC_SOC;
+        ret = mlx90632_sensor_async_write(dev, MLX90632_REG_STATUS, reg_status & ~MLX90632_STAT_DATA_RDY);
+        break;
+    case MLX90632_ASYNC_SOC:
+        data->async_stage = MLX90632_ASYNC_CONVERTING;
+        ret = mlx90632_sensor_async_write(dev, MLX90632_REG_CTRL, data->reg_ctrl | MLX90632_CFG_SOC_MASK);
+        break;
+    case MLX90632_ASYNC_CONVERTING:
+        data->async_stage = MLX90632_ASYNC_STATUS;
+        data->async_tries = MLX90632_MAX_NUMBER_MESUREMENT_READ_TRIES;
+        k_work_reschedule(dwork, K_USEC(data->conv_time_us - data->conv_time_us / MLX90632_WAKEUP_MARGIN_DIV));
+        break;
+    case MLX90632_ASYNC_STATUS:
+        data->async_stage = MLX90632_ASYNC_STATUS_DONE;
+        ret = mlx90632_sensor_async_read(dev, MLX90632_REG_STATUS, 1);
+        break;
+    case MLX90632_ASYNC_STATUS_DONE:
+        reg_status = mlx90632_sensor_async_word(data);
+        if (!(reg_status & MLX90632_STAT_DATA_RDY)){
+            if (--data->async_tries <= 0){
+                ret = -ETIMEDOUT;
+                break;
+            }
+            poll_interval = MAX(data->conv_time_us / MLX90632_POLL_INTERVAL_DIV, MLX90632_MIN_POLL_INTERVAL);
+            data->async_stage = MLX90632_ASYNC_STATUS;
+            k_work_reschedule(dwork, K_USEC(poll_interval));
+            break;
+        }
+        data->async_cycle_pos = (int)(reg_status & (uint16_t)MLX90632_STAT_CYCLE_POS) >> 2;
+        if ((data->async_cycle_pos != 1) && (data->async_cycle_pos != 2)){
+            ret = -EIO;
+            break;
+        }
+        data->async_stage = MLX90632_ASYNC_RAM_DONE;
+        ret = mlx90632_sensor_async_read(dev, MLX90632_RAM_BLOCK_START, MLX90632_RAM_BLOCK_LEN);
+        break;
+    case MLX90632_ASYNC_RAM_DONE:
+        mlx90632_sensor_async_complete(data, 0);
+        break;
+    }
+
+    if (ret)
+        mlx90632_sensor_async_complete(data, ret);
+}
+
+int mlx90632_read_async(const struct device *dev, MLXAsyncCallback_t cb, void *user){
+    struct mlx90632_sensor_data *data = dev->data;
+
+    k_mutex_lock(&data->lock, K_FOREVER);
+    if ((data->handler != NULL) || data->async_busy){
+        k_mutex_unlock(&data->lock);
+        return -EBUSY;
+    }
+    data->async_busy = true;
+    data->async_cb = cb;
+    data->async_user = user;
+    data->async_result = 0;
+    data->async_stage = MLX90632_ASYNC_CLEAR;
+    k_mutex_unlock(&data->lock);
+
+    k_work_reschedule(&data->async_work, K_NO_WAIT);
+    return 0;
+}
+
+static int mlx90632_sensor_trigger_set(const struct device *dev, const struct sensor_trigger *trig,
+                                       sensor_trigger_handler_t handler){
+    struct mlx90632_sensor_data *data = dev->data;
+    k_timeout_t period;
+    int ret;
+
+    if (trig->type != SENSOR_TRIG_DATA_READY)
+        return -ENOTSUP;
+
+    k_mutex_lock(&data->lock, K_FOREVER);
+    if (data->async_busy){
+        k_mutex_unlock(&data->lock);
+        return -EBUSY;
+    }
+    k_timer_stop(&data->timer);
+    data->handler = handler;
+    data->trigger = trig;
+    if (handler != NULL){
+        ret = mlx90632_sensor_set_mode(dev, MLX90632_PWR_STATUS_CONTINUOUS);
+        //data ready left from sleeping step mode is not a new sample
+        if (ret == 0)
+            ret = mlx90632_sensor_clear_ready(dev);
+        if (ret == 0){
+            period = K_USEC(data->conv_time_us / MLX90632_SENSOR_POLL_DIV);
+            k_timer_start(&data->timer, period, period);
+        } else {
+            data->handler = NULL;
+        }
+    } else {
+        ret = mlx90632_sensor_set_mode(dev, MLX90632_PWR_STATUS_SLEEP_STEP);
+    }
+    k_mutex_unlock(&data->lock);
+
+    return ret;
+}
+
+static int mlx90632_sensor_sample_fetch(const struct device *dev, enum sensor_channel chan){
+    struct mlx90632_sensor_data *data = dev->data;
+    int ret;
+
+    if ((chan != SENSOR_CHAN_ALL) && (chan != SENSOR_CHAN_AMBIENT_TEMP) && (chan != SENSOR_CHAN_DIE_TEMP) &&
+        (chan != (enum sensor_channel)SENSOR_CHAN_MLX90632_OBJECT_TEMP))
+        return -ENOTSUP;
+
+    k_mutex_lock(&data->lock, K_FOREVER);
+    //in trigger mode the sample was read by the trigger work
+    if (data->async_busy)
+        ret = -EBUSY;
+    else
+        ret = (data->handler != NULL) ? 0 : mlx90632_sensor_measure(dev);
+    k_mutex_unlock(&data->lock);
+
+    if (ret)
+        LOG_ERR("%s: measurement failed (%d)", dev->name, ret);
+    return ret;
+}
+
+static void mlx90632_sensor_value(double value, struct sensor_value *val){
+    val->val1 = (int32_t)value;
+    val->val2 = (int32_t)((value - val->val1) * 1000000.0);
+}
+
+static int mlx90632_sensor_channel_get(const struct device *dev, enum sensor_channel chan,
+                                       struct sensor_value *val){
+    struct mlx90632_sensor_data *data = dev->data;
+    double value;
+
+    k_mutex_lock(&data->lock, K_FOREVER);
+    if ((chan == SENSOR_CHAN_AMBIENT_TEMP) || (chan == SENSOR_CHAN_DIE_TEMP)){
+        value = data->temp.ambient;
+    } else if (chan == (enum sensor_channel)SENSOR_CHAN_MLX90632_OBJECT_TEMP){
+        value = data->temp.object;
+    } else {
+        k_mutex_unlock(&data->lock);
+        return -ENOTSUP;
+    }
+    k_mutex_unlock(&data->lock);
+
+    mlx90632_sensor_value(value, val);
+    return 0;
+}
+
+static int mlx90632_sensor_attr_set(const struct device *dev, enum sensor_channel chan,
+                                    enum sensor_attribute attr, const struct sensor_value *val){
+    struct mlx90632_sensor_data *data = dev->data;
+    double emissivity;
+
+    if (attr != (enum sensor_attribute)SENSOR_ATTR_MLX90632_EMISSIVITY)
+        return -ENOTSUP;
+
+    emissivity = sensor_value_to_double(val);
+    if ((emissivity <= 0.0) || (emissivity > 1.0))
+        return -EINVAL;
+
+    k_mutex_lock(&data->lock, K_FOREVER);
+    data->emissivity = emissivity;
+    mlx90632_prepare(&data->calib, data->emissivity, &data->prep);
+    mlx90632_solver_invalidate(&data->solver);
+    k_mutex_unlock(&data->lock);
+
+    return 0;
+}
+
+static const struct sensor_driver_api mlx90632_sensor_api = {
+    .attr_set = mlx90632_sensor_attr_set,
+    .trigger_set = mlx90632_sensor_trigger_set,
+    .sample_fetch = mlx90632_sensor_sample_fetch,
+    .channel_get = mlx90632_sensor_channel_get,
+};
+
+static int mlx90632_sensor_init(const struct device *dev){
+    const struct mlx90632_sensor_config *cfg = dev->config;
+    struct mlx90632_sensor_data *data = dev->data;
+    MLXEeprom_s ee;
+    uint16_t eeprom_version, meas1;
+    int ret;
+
+    if (!device_is_ready(cfg->i2c.bus)){
+        LOG_ERR("%s: i2c bus not ready", dev->name);
+        return -ENODEV;
+    }
+
+    data->dev = dev;
+    k_mutex_init(&data->lock);
+    k_work_init(&data->work, mlx90632_sensor_work);
+    k_work_init_delayable(&data->async_work, mlx90632_sensor_async_work);
+    k_timer_init(&data->timer, mlx90632_sensor_timer, NULL);
+
+    ret = mlx90632_sensor_read(dev, MLX90632_EE_VERSION, &eeprom_version);
+    if (ret){
+        LOG_ERR("%s: no sensor at 0x%02x (%d)", dev->name, cfg->i2c.addr, ret);
+        return ret;
+    }
+    if ((eeprom_version & 0x00FF) != MLX90632_DSPv5){
+        LOG_ERR("%s: unsupported eeprom version 0x%04x", dev->name, eeprom_version);
+        return -ENOTSUP;
+    }
+    if ((eeprom_version & 0x7F00) == MLX90632_XTD_RNG_KEY)
+        LOG_WRN("%s: extended range sensor, medical measurement used", dev->name);
+
+    ret = mlx90632_sensor_read_block(dev, MLX90632_EE_CALIB_START, ee.calib, MLX90632_EE_CALIB_LEN);
+    if (ret == 0)
+        ret = mlx90632_sensor_read_block(dev, MLX90632_EE_CUSTOMER_START, ee.customer, MLX90632_EE_CUSTOMER_LEN);
+    if (ret == 0)
+        ret = mlx90632_sensor_read(dev, MLX90632_EE_MEDICAL_MEAS1, &meas1);
+    if (ret)
+        return ret;
+
+    mlx90632_decodeCalib(&ee, &data->calib);
+    data->conv_time_us = mlx90632_calc_conv_time((mlx90632_meas_t)MLX90632_REFRESH_RATE(meas1));
+    data->emissivity = cfg->emissivity_milli / 1000.0;
+    mlx90632_prepare(&data->calib, data->emissivity, &data->prep);
+    mlx90632_solver_init(&data->solver, MLX_SOLVER_TOLERANCE, MLX90632_SOLVER_MAX_ITER);
+
+    ret = mlx90632_sensor_set_mode(dev, MLX90632_PWR_STATUS_SLEEP_STEP);
+    if (ret)
+        return ret;
+
+    // Prepare a clean start with setting NEW_DATA to 0
+    return mlx90632_sensor_clear_ready(dev);
+}
+
+#define MLX90632_SENSOR(n)                                                                  \
+    static struct mlx90632_sensor_data mlx90632_sensor_data_##n;                            \
+    static const struct mlx90632_sensor_config mlx90632_sensor_config_##n = {               \
+        .i2c = I2C_DT_SPEC_INST_GET(n),                                                     \
+        .emissivity_milli = DT_INST_PROP(n, emissivity_milli),                              \
+    };                                                                                      \
+    DEVICE_DT_INST_DEFINE(n, mlx90632_sensor_init, NULL, &mlx90632_sensor_data_##n,         \
+                          &mlx90632_sensor_config_##n, POST_KERNEL,                         \
+                          CONFIG_SENSOR_INIT_PRIORITY, &mlx90632_sensor_api);
+
+DT_INST_FOREACH_STATUS_OKAY(MLX90632_SENSOR)
@@ -0,0 +1,154 @@
+/******************************************************************************
+ * Copyright (c) 2025 Marconatale Parise.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * You may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************/
+/**
+ * @file mlx90632_stream.c
+ * @brief binary frames of the melexis sample stream
+ *
+ * Fields are written byte by byte, so the frame does not depend on struct packing or on the
+ * endianness of the encoder and decoder.
+ *
+ */
+#include <string.h>
+#include "mlx90632_stream.h"
+
+static void mlx90632_stream_put16(uint8_t *p, uint16_t value){
+    p[0] = (uint8_t)(value & 0xFF);
+    p[1] = (uint8_t)(value >> 8);
+}
+
+static void mlx90632_stream_put32(uint8_t *p, uint32_t value){
+    mlx90632_stream_put16(p, (uint16_t)(value & 0xFFFF));
+    mlx90632_stream_put16(p + 2, (uint16_t)(value >> 16));
+}
+
+static uint16_t mlx90632_stream_get16(const uint8_t *p){
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static uint32_t mlx90632_stream_get32(const uint8_t *p){
+    return mlx90632_stream_get16(p) | ((uint32_t)mlx90632_stream_get16(p + 2) << 16);
+}
+
+uint16_t mlx90632_stream_crc16(const uint8_t *buf, size_t len){
+    uint16_t crc = 0xFFFF;
+    size_t i;
+    int bit;
+
+    for (i = 0; i < len; i++){
+        crc ^= (uint16_t)buf[i] << 8;
+        for (bit = 0; bit < 8; bit++)
+            crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ 0x1021) : (uint16_t)(crc << 1);
+    }
+    return crc;
+}
+
+int16_t mlx90632_stream_centi(double temp){
+    double centi = temp * 100.0;
+
+    if (centi >= 32767.0)
+        return INT16_MAX;
+    if (centi <= -32768.0)
+        return INT16_MIN;
+    return (int16_t)((centi < 0) ? (centi - 0.5) : (centi + 0.5));
+}
+
+void mlx90632_stream_encode(const MLXStreamRecord_s *rec, uint8_t *frame){
+    frame[0] = MLX90632_STREAM_SYNC0;
+    frame[1] = MLX90632_STREAM_SYNC1;
+    frame[2] = MLX90632_STREAM_VERSION;
+    frame[3] = rec->sensor_id;
+    mlx90632_stream_put16(&frame[4], rec->seq);
+    frame[6] = rec->cycle_pos;
+    frame[7] = rec->flags;
+    mlx90632_stream_put32(&frame[8], rec->timestamp_us);
+    mlx90632_stream_put16(&frame[12], (uint16_t)rec->raw.ambient_ram_6);
+    mlx90632_stream_put16(&frame[14], (uint16_t)rec->raw.ambient_ram_9);
+    mlx90632_stream_put16(&frame[16], (uint16_t)rec->raw.object_ram_4_7);
+    mlx90632_stream_put16(&frame[18], (uint16_t)rec->raw.object_ram_5_8);
+    mlx90632_stream_put16(&frame[20], (uint16_t)rec->ambient_centi);
+    mlx90632_stream_put16(&frame[22], (uint16_t)rec->object_centi);
+    mlx90632_stream_put16(&frame[24], mlx90632_stream_crc16(&frame[2], MLX90632_STREAM_FRAME_LEN - 4));
+}
+
+int mlx90632_stream_decode(const uint8_t *frame, MLXStreamRecord_s *rec){
+    if ((frame[0] != MLX90632_STREAM_SYNC0) || (frame[1] != MLX90632_STREAM_SYNC1) ||
+        (frame[2] != MLX90632_STREAM_VERSION))
+        return -EBADMSG;
+    if (mlx90632_stream_get16(&frame[24]) != mlx90632_stream_crc16(&frame[2], MLX90632_STREAM_FRAME_LEN - 4))
+        return -EBADMSG;
+
+    rec->sensor_id = frame[3];
+    rec->seq = mlx90632_stream_get16(&frame[4]);
+    rec->cycle_pos = frame[6];
+    rec->flags = frame[7];
+    rec->timestamp_us = mlx90632_stream_get32(&frame[8]);
+    rec->raw.ambient_ram_6 = (int16_t)mlx90632_stream_get16(&frame[12]);
+    rec->raw.ambient_ram_9 = (int16_t)mlx90632_stream_get16(&frame[14]);
+    rec->raw.object_ram_4_7 = (int16_t)mlx90632_stream_get16(&frame[16]);
+    rec->raw.object_ram_5_8 = (int16_t)mlx90632_stream_get16(&frame[18]);
+    rec->ambient_centi = (int16_t)mlx90632_stream_get16(&frame[20]);
+    rec->object_centi = (int16_t)mlx90632_stream_get16(&frame[22]);
+    return 0;
+}
+
+void mlx90632_stream_decoder_init(MLXStreamDecoder_s *dec){
+    memset(dec, 0, sizeof(*dec));
+}
+
+/* Drop bytes up to the next sync candidate after the first byte of a bad frame */
+static void mlx90632_stream_resync(MLXStreamDecoder_s *dec){
+    uint8_t i;
+
+    for (i = 1; i < dec->len; i++){
+        if ((dec->buf[i] == MLX90632_STREAM_SYNC0) &&
+            ((i + 1 == dec->len) || (dec->buf[i + 1] == MLX90632_STREAM_SYNC1)))
+            break;
+    }
+    memmove(dec->buf, &dec->buf[i], dec->len - i);
+    dec->len -= i;
+    dec->skipped += i;
+}
+
+int mlx90632_stream_feed(MLXStreamDecoder_s *dec, uint8_t byte, MLXStreamRecord_s *rec){
+    dec->buf[dec->len++] = byte;
+
+    if ((dec->len == 1) && (byte != MLX90632_STREAM_SYNC0)){
+        dec->len = 0;
+        dec->skipped++;
+        return 0;
+    }
+    if ((dec->len == 2) && (byte != MLX90632_STREAM_SYNC1)){
+        mlx90632_stream_resync(dec);
+        return 0;
+    }
+    if (dec->len < MLX90632_STREAM_FRAME_LEN)
+        return 0;
+
+    if (mlx90632_stream_decode(dec->buf, rec) < 0){
+        dec->crc_errors++;
+        mlx90632_stream_resync(dec);
+        return 0;
+    }
+
+    dec->len = 0;
+    if (dec->synced)
+        dec->lost += (uint16_t)(rec->seq - dec->next_seq);
+    dec->synced = true;
+    dec->next_seq = rec->seq + 1;
+    dec->frames++;
+    return 1;
+}
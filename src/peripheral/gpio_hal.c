@@ -27,9 +27,12 @@
  */
 #include "gpio_hal.h"
 
+LOG_MODULE_DECLARE(peripheral, CONFIG_PERIPHERAL_LOG_LEVEL);
+
 uint8_t error_gpio = 0;
 
 static struct gpio_callback cb;
+static gpio_event_handler_t event_handler;
 
 Gpio_t gpio_a[NUM_GPIO_PERIP] = {
 	{
@@ -73,13 +76,22 @@ void gpio_enable(Gpio_t* gt, uint8_t channel, bool enable){
 	gt[channel].active = enable;
 }
 
+void gpio_set_event_handler(gpio_event_handler_t handler){
+	event_handler = handler;
+}
+
 void interrupt_callback(const struct device *dev, struct gpio_callback *cb, uint32_t pins){
+	uint32_t channels = 0;
+
 	for (int i = 0; i < NUM_GPIO_PERIP; i++) {
 		if (pins & BIT(gpio_a[i].pin)) {
 			gpio_a[i].g_int.status = true;
+			channels |= BIT(i);
 			LOG("GPIO interrupt triggered for %s", gpio_a[i].label);
     	}
 	}
+	if (channels && event_handler)
+		event_handler(channels);
 }
 
 
@@ -160,4 +172,10 @@ bool get_gpio_interrupt_status(Gpio_t* gt, uint8_t channel){
 	}else{
 		return false;
 	}
-}
\ No newline at end of file
+}
+
+bool get_gpio_level(Gpio_t* gt, uint8_t channel){
+	if (!gt[channel].active)
+		return false;
+	return gpio_pin_get(gt[channel].dev, gt[channel].pin) > 0;
+}
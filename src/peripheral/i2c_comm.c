@@ -27,6 +27,8 @@
  */
 #include "i2c_comm.h"
 
+LOG_MODULE_DECLARE(peripheral, CONFIG_PERIPHERAL_LOG_LEVEL);
+
 
 bool i2c_init(){
 
@@ -20,14 +20,37 @@
  */
 #include "peripheral.h"
 
+LOG_MODULE_REGISTER(peripheral, CONFIG_PERIPHERAL_LOG_LEVEL);
+
 
 extern Gpio_t gpio_a[NUM_GPIO_PERIP]; // array of gpio peripheral
 
+static atomic_t peripheral_events; // bits posted and not yet consumed
+K_SEM_DEFINE(peripheral_event_sem, 0, 1);
+
+/* Button 2 still held PERIPHERAL_LONG_PRESS after its edge: shutdown */
+static void peripheral_long_press(struct k_timer *timer){
+  if (get_gpio_level(gpio_a, BTN2_ch))
+    peripheral_post_event(PERIPHERAL_EVT_SHUTDOWN);
+}
+
+K_TIMER_DEFINE(peripheral_long_press_timer, peripheral_long_press, NULL);
+
+/* Every edge is posted, button 2 also (re)starts the long press timer */
+static void peripheral_gpio_event(uint32_t channels){
+  peripheral_post_event(channels);
+  if (channels & BIT(BTN2_ch))
+    k_timer_start(&peripheral_long_press_timer, K_MSEC(PERIPHERAL_LONG_PRESS), K_NO_WAIT);
+}
+
 
 /***********************************************************
  Function Definitions
 ***********************************************************/
 void peripheral_init() {
+  //Button edges are posted as events to the main loop, a long press of button 2 as shutdown
+  gpio_set_event_handler(peripheral_gpio_event);
+
   //Button 1 to start reading measurements
   gpio_enable(gpio_a, BTN1_ch, true);
   gpio_enable_interrupt(gpio_a, BTN1_ch, true);
@@ -35,7 +58,7 @@ void peripheral_init() {
   gpio_configure(gpio_a, BTN1_ch, NUM_GPIO_PERIP);
   gpio_configure_interrupt(gpio_a, BTN1_ch, NUM_GPIO_PERIP); 
 
-  //Button 2 to stop reading measurements
+  //Button 2 to stop reading measurements, held down PERIPHERAL_LONG_PRESS to shut down
   gpio_enable(gpio_a, BTN2_ch, true);
   gpio_enable_interrupt(gpio_a, BTN2_ch, true);
   gpio_init(gpio_a, BTN2_ch, NUM_GPIO_PERIP);
@@ -50,7 +73,7 @@ void peripheral_init() {
     return;
   }else{
     mlx90632_init();
-    LOG("Peripheral initialized successfully.\n");
+    LOG("Peripheral initialized successfully.");
   }
   
 }
@@ -74,5 +97,15 @@ bool is_button2_pressed(){
 	return status; 
 }
 
+void peripheral_post_event(uint32_t events){
+  atomic_or(&peripheral_events, events);
+  k_sem_give(&peripheral_event_sem);
+}
 
-
+/* The bits are cleared after the wake up: a post racing with the clear gives the semaphore again
+ * and costs one empty wake up at most, never a lost event */
+uint32_t peripheral_wait_event(k_timeout_t timeout){
+  if (k_sem_take(&peripheral_event_sem, timeout) < 0)
+    return 0;
+  return (uint32_t)atomic_clear(&peripheral_events);
+}
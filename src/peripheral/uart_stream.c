@@ -0,0 +1,138 @@
+/******************************************************************************
+ * Copyright (c) 2025 Marconatale Parise.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * You may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************/
+/**
+ * @file uart_stream.c
+ * @brief uart transport of the binary sample stream
+ *
+ * uart_stream_send() may run in any thread, the tx callback runs in interrupt context:
+ * buffers and counters are protected by a spinlock. The next buffer is started from the
+ * tx done callback, so frames queued during a transfer leave without the sender waiting.
+ *
+ */
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/device.h>
+#include <zephyr/drivers/uart.h>
+#include "uart_stream.h"
+
+LOG_MODULE_DECLARE(peripheral, CONFIG_PERIPHERAL_LOG_LEVEL);
+
+#define UART_STREAM_BUF_LEN (UART_STREAM_BUF_FRAMES * MLX90632_STREAM_FRAME_LEN)
+
+static const struct device *stream_dev;
+static struct k_spinlock stream_lock;
+static uint8_t stream_buf[2][UART_STREAM_BUF_LEN];
+static size_t stream_len[2];
+static uint8_t stream_fill;     //buffer being filled, the other one may be in transfer
+static bool stream_busy;
+static bool stream_async;
+static uint16_t stream_seq;
+static UartStreamStats_s stream_stats;
+
+#ifdef CONFIG_UART_ASYNC_API
+/* Transmit the buffer being filled and switch to the other one, lock held */
+static void uart_stream_start_locked(void){
+    uint8_t tx = stream_fill;
+
+    stream_fill ^= 1;
+    stream_busy = true;
+    if (uart_tx(stream_dev, stream_buf[tx], stream_len[tx], SYS_FOREVER_US) != 0){
+        stream_stats.errors++;
+        stream_len[tx] = 0;
+        stream_busy = false;
+    }
+}
+
+static void uart_stream_callback(const struct device *dev, struct uart_event *evt, void *user_data){
+    k_spinlock_key_t key;
+
+    if ((evt->type != UART_TX_DONE) && (evt->type != UART_TX_ABORTED))
+        return;
+
+    key = k_spin_lock(&stream_lock);
+    if (evt->type == UART_TX_ABORTED)
+        stream_stats.errors++;
+    stream_len[stream_fill ^ 1] = 0;
+    stream_busy = false;
+    if (stream_len[stream_fill] > 0)
+        uart_stream_start_locked();
+    k_spin_unlock(&stream_lock, key);
+}
+#endif
+
+int uart_stream_init(void){
+#if DT_NODE_EXISTS(DT_ALIAS(mlx_stream))
+    stream_dev = DEVICE_DT_GET(DT_ALIAS(mlx_stream));
+#endif
+    if ((stream_dev == NULL) || !device_is_ready(stream_dev)){
+        LOG("Stream uart not available");
+        stream_dev = NULL;
+        return -ENODEV;
+    }
+
+#ifdef CONFIG_UART_ASYNC_API
+    stream_async = (uart_callback_set(stream_dev, uart_stream_callback, NULL) == 0);
+#endif
+    if (!stream_async)
+        LOG("Stream uart without async API, frames sent by polling");
+    return 0;
+}
+
+int uart_stream_send(MLXStreamRecord_s *rec){
+    uint8_t frame[MLX90632_STREAM_FRAME_LEN];
+    k_spinlock_key_t key;
+    size_t i;
+    int ret = 0;
+
+    if (stream_dev == NULL)
+        return -ENODEV;
+
+    key = k_spin_lock(&stream_lock);
+    rec->seq = stream_seq++;
+    stream_stats.frames++;
+    k_spin_unlock(&stream_lock, key);
+
+    mlx90632_stream_encode(rec, frame);
+
+    if (!stream_async){
+        for (i = 0; i < sizeof(frame); i++)
+            uart_poll_out(stream_dev, frame[i]);
+        return 0;
+    }
+
+#ifdef CONFIG_UART_ASYNC_API
+    key = k_spin_lock(&stream_lock);
+    if (stream_len[stream_fill] + sizeof(frame) > UART_STREAM_BUF_LEN){
+        stream_stats.dropped++;
+        ret = -ENOMEM;
+    } else {
+        memcpy(&stream_buf[stream_fill][stream_len[stream_fill]], frame, sizeof(frame));
+        stream_len[stream_fill] += sizeof(frame);
+        if (!stream_busy)
+            uart_stream_start_locked();
+    }
+    k_spin_unlock(&stream_lock, key);
+#endif
+    return ret;
+}
+
+void uart_stream_get_stats(UartStreamStats_s *stats){
+    k_spinlock_key_t key = k_spin_lock(&stream_lock);
+
+    *stats = stream_stats;
+    k_spin_unlock(&stream_lock, key);
+}
@@ -0,0 +1,200 @@
+/******************************************************************************
+ * Copyright (c) 2025 Marconatale Parise.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * You may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************/
+/**
+ * @file main.c
+ * @brief tests of the melexis calibration cache on the native_posix flash simulator
+ *
+ * The bus of the library is a fingerprint window in RAM, flash writes are detected from the
+ * free space of the NVS file system behind settings.
+ *
+ */
+#include <string.h>
+#include <zephyr/ztest.h>
+#include <zephyr/fs/nvs.h>
+#include <zephyr/settings/settings.h>
+#include "mlx90632_cache.h"
+#include "mlx90632_hal.h"
+
+LOG_MODULE_REGISTER(mlx90632, CONFIG_MLX90632_LOG_LEVEL);
+
+#define TEST_ID_A 0x3A
+#define TEST_ID_B 0x3C
+
+static uint16_t fake_fp[MLX90632_EE_FINGERPRINT_LEN];
+
+static int32_t fake_read(void *ctx, uint16_t reg, uint16_t *value){
+    return -EIO;
+}
+
+static int32_t fake_write(void *ctx, uint16_t reg, uint16_t value){
+    return -EIO;
+}
+
+static int32_t fake_read_block(void *ctx, uint16_t reg, uint16_t *value, uint16_t len){
+    if ((reg < MLX90632_EE_FINGERPRINT_START) || (reg + len > MLX90632_EE_FINGERPRINT_START + MLX90632_EE_FINGERPRINT_LEN))
+        return -EIO;
+    memcpy(value, &fake_fp[reg - MLX90632_EE_FINGERPRINT_START], len * sizeof(*value));
+    return 0;
+}
+
+static void fake_sleep_us(void *ctx, uint32_t us){
+}
+
+static uint64_t fake_now_us(void *ctx){
+    return k_ticks_to_us_floor64(k_uptime_ticks());
+}
+
+/* default bus of hal.c on Zephyr, the i2c backend is not built */
+const MLXBus_s mlx90632_bus_zephyr = {
+    .read = fake_read,
+    .write = fake_write,
+    .read_block = fake_read_block,
+    .sleep_us = fake_sleep_us,
+    .now_us = fake_now_us,
+    .ctx = NULL,
+};
+
+static void test_eeprom(MLXEeprom_s *ee, MLXCalib_s *calib, uint16_t seed){
+    size_t i;
+
+    for (i = 0; i < MLX90632_EE_CALIB_LEN; i++)
+        ee->calib[i] = (uint16_t)(seed + i);
+    for (i = 0; i < MLX90632_EE_CUSTOMER_LEN; i++)
+        ee->customer[i] = (uint16_t)(seed ^ i);
+
+    memset(calib, 0, sizeof(*calib));
+    calib->P_R = 22399.0f + seed;
+    calib->Gb = 9.5f;
+    calib->Ka = 10.5f;
+    calib->Ha = 1.0f;
+}
+
+static ssize_t test_free_space(void){
+    void *storage;
+
+    zassert_ok(settings_storage_get(&storage), "no settings storage");
+    return nvs_calc_free_space((struct nvs_fs *)storage);
+}
+
+/* Sensor A read from eeprom: the cache misses and the calibration is stored */
+static void test_store(uint16_t id, uint16_t seed, MLXEeprom_s *ee, MLXCalib_s *calib){
+    MLXCalib_s loaded;
+
+    test_eeprom(ee, calib, seed);
+    zassert_equal(mlx90632_cache_load(id, &loaded), -ENOENT, "empty cache hit");
+    zassert_ok(mlx90632_cache_store(id, ee, calib), "store failed");
+}
+
+static void cache_before(void *fixture){
+    size_t i;
+
+    for (i = 0; i < MLX90632_EE_FINGERPRINT_LEN; i++)
+        fake_fp[i] = (uint16_t)(0x1234 + i);
+    fake_fp[MLX90632_EE_VERSION - MLX90632_EE_FINGERPRINT_START] = 0x0100 | MLX90632_DSPv5;
+
+    zassert_ok(settings_subsys_init(), "settings init failed");
+    mlx90632_cache_reset();
+    (void)mlx90632_cache_invalidate(TEST_ID_A);
+    (void)mlx90632_cache_invalidate(TEST_ID_B);
+    mlx90632_cache_reset();
+}
+
+ZTEST(mlx90632_cache, test_store_load){
+    MLXEeprom_s ee;
+    MLXCalib_s calib, loaded;
+
+    test_store(TEST_ID_A, 1, &ee, &calib);
+
+    //the record comes from flash, not from RAM
+    mlx90632_cache_reset();
+    memset(&loaded, 0, sizeof(loaded));
+    zassert_ok(mlx90632_cache_load(TEST_ID_A, &loaded), "cache miss after store");
+    zassert_mem_equal(&loaded, &calib, sizeof(calib), "calibration differs");
+}
+
+ZTEST(mlx90632_cache, test_fingerprint_mismatch){
+    MLXEeprom_s ee;
+    MLXCalib_s calib, loaded;
+
+    test_store(TEST_ID_A, 1, &ee, &calib);
+
+    //another chip on the same address
+    fake_fp[0] ^= 0x0001;
+    mlx90632_cache_reset();
+    zassert_equal(mlx90632_cache_load(TEST_ID_A, &loaded), -ENOENT, "hit with another chip ID");
+
+    //same chip, eeprom version changed
+    fake_fp[0] ^= 0x0001;
+    fake_fp[MLX90632_EE_VERSION - MLX90632_EE_FINGERPRINT_START] ^= 0x0200;
+    mlx90632_cache_reset();
+    zassert_equal(mlx90632_cache_load(TEST_ID_A, &loaded), -ENOENT, "hit with another eeprom version");
+}
+
+ZTEST(mlx90632_cache, test_invalidate){
+    MLXEeprom_s ee;
+    MLXCalib_s calib, loaded;
+
+    test_store(TEST_ID_A, 1, &ee, &calib);
+
+    zassert_ok(mlx90632_cache_invalidate(TEST_ID_A), "invalidate failed");
+    zassert_equal(mlx90632_cache_load(TEST_ID_A, &loaded), -ENOENT, "hit after invalidate");
+
+    mlx90632_cache_reset();
+    zassert_equal(mlx90632_cache_load(TEST_ID_A, &loaded), -ENOENT, "record still in flash");
+}
+
+ZTEST(mlx90632_cache, test_no_rewrite){
+    MLXEeprom_s ee;
+    MLXCalib_s calib, loaded;
+    ssize_t free_space;
+
+    test_store(TEST_ID_A, 1, &ee, &calib);
+
+    //same eeprom read again: no flash write
+    free_space = test_free_space();
+    zassert_ok(mlx90632_cache_load(TEST_ID_A, &loaded), "cache miss after store");
+    zassert_ok(mlx90632_cache_store(TEST_ID_A, &ee, &calib), "store failed");
+    zassert_equal(test_free_space(), free_space, "unchanged calibration rewritten");
+
+    //calibration words rewritten: new record
+    ee.customer[0] ^= 0x0100;
+    calib.Ha = 0.5f;
+    zassert_ok(mlx90632_cache_store(TEST_ID_A, &ee, &calib), "store failed");
+    zassert_true(test_free_space() < free_space, "changed calibration not written");
+}
+
+ZTEST(mlx90632_cache, test_per_sensor){
+    MLXEeprom_s ee_a, ee_b;
+    MLXCalib_s calib_a, calib_b, loaded;
+
+    test_store(TEST_ID_A, 1, &ee_a, &calib_a);
+    test_store(TEST_ID_B, 2, &ee_b, &calib_b);
+
+    mlx90632_cache_reset();
+    zassert_ok(mlx90632_cache_load(TEST_ID_A, &loaded), "sensor A miss");
+    zassert_mem_equal(&loaded, &calib_a, sizeof(loaded), "sensor A calibration differs");
+    zassert_ok(mlx90632_cache_load(TEST_ID_B, &loaded), "sensor B miss");
+    zassert_mem_equal(&loaded, &calib_b, sizeof(loaded), "sensor B calibration differs");
+
+    //dropping one sensor keeps the other
+    zassert_ok(mlx90632_cache_invalidate(TEST_ID_B), "invalidate failed");
+    mlx90632_cache_reset();
+    zassert_ok(mlx90632_cache_load(TEST_ID_A, &loaded), "sensor A dropped with B");
+    zassert_equal(mlx90632_cache_load(TEST_ID_B, &loaded), -ENOENT, "sensor B still cached");
+}
+
+ZTEST_SUITE(mlx90632_cache, NULL, NULL, cache_before, NULL, NULL);